@@ -0,0 +1,350 @@
+#ifndef IGOR_ALLOCATOR_HPP_
+#define IGOR_ALLOCATOR_HPP_
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <memory_resource>
+#include <new>
+#include <vector>
+
+#include <sys/mman.h>
+
+namespace Igor {
+
+// -------------------------------------------------------------------------------------------------
+enum class PageKind : std::uint8_t {
+  DEFAULT,           // Regular pages as provided by the C allocator
+  TRANSPARENT_HUGE,  // Anonymous mapping advised with `madvise(MADV_HUGEPAGE)`
+  EXPLICIT_HUGE,     // Mapping with explicit 2 MB pages (`MAP_HUGETLB`), falls back to transparent
+};
+
+namespace detail {
+
+inline constexpr size_t HUGE_PAGE_SIZE = 2UZ * 1024UZ * 1024UZ;
+// Smallest page size of the supported platforms, the alignment of every anonymous mapping
+inline constexpr size_t MIN_PAGE_SIZE = 4096UZ;
+// Over-aligned allocations of at least this size come from anonymous mappings, like large
+// allocations in glibc's malloc, s.t. zero-initialized memory is zeroed lazily by the kernel
+inline constexpr size_t MAPPING_THRESHOLD = 1UZ << 17UZ;
+
+[[nodiscard]] constexpr auto round_up(size_t n, size_t multiple) noexcept -> size_t {
+  return ((n + multiple - 1UZ) / multiple) * multiple;
+}
+
+// Map `bytes` (multiple of HUGE_PAGE_SIZE) aligned to HUGE_PAGE_SIZE s.t. the kernel can back the
+// mapping with transparent huge pages.
+[[nodiscard]] inline auto map_transparent_huge(size_t bytes) noexcept -> void* {
+  // Over-allocate by one huge page and trim the unaligned head and the tail
+  const size_t mapped_bytes = bytes + HUGE_PAGE_SIZE;
+  void* mapped =
+      mmap(nullptr, mapped_bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  if (mapped == MAP_FAILED) { return nullptr; }
+
+  const auto begin         = reinterpret_cast<std::uintptr_t>(mapped);  // NOLINT
+  const auto aligned_begin = round_up(begin, HUGE_PAGE_SIZE);
+  const size_t head        = aligned_begin - begin;
+  const size_t tail        = mapped_bytes - head - bytes;
+  // NOLINTBEGIN(performance-no-int-to-ptr, cppcoreguidelines-pro-type-reinterpret-cast)
+  if (head > 0UZ) { munmap(mapped, head); }
+  if (tail > 0UZ) { munmap(reinterpret_cast<void*>(aligned_begin + bytes), tail); }
+  void* aligned = reinterpret_cast<void*>(aligned_begin);
+  // NOLINTEND(performance-no-int-to-ptr, cppcoreguidelines-pro-type-reinterpret-cast)
+
+#ifdef MADV_HUGEPAGE
+  madvise(aligned, bytes, MADV_HUGEPAGE);
+#endif  // MADV_HUGEPAGE
+  return aligned;
+}
+
+// Map `bytes` (multiple of HUGE_PAGE_SIZE) with explicit huge pages, requires that huge pages were
+// reserved (`/proc/sys/vm/nr_hugepages`).
+[[nodiscard]] inline auto map_explicit_huge([[maybe_unused]] size_t bytes) noexcept -> void* {
+#ifdef MAP_HUGETLB
+  int flags = MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB;
+#ifdef MAP_HUGE_SHIFT
+  flags |= 21 << MAP_HUGE_SHIFT;  // 2^21 bytes = 2 MB
+#endif  // MAP_HUGE_SHIFT
+  void* mapped = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, flags, -1, 0);
+  return mapped == MAP_FAILED ? nullptr : mapped;
+#else
+  return nullptr;
+#endif  // MAP_HUGETLB
+}
+
+}  // namespace detail
+
+// -------------------------------------------------------------------------------------------------
+// Allocator with a configurable alignment and page kind. Allocations smaller than a huge page
+// always use regular pages.
+template <typename T, size_t ALIGNMENT = alignof(T), PageKind PAGES = PageKind::DEFAULT>
+class AlignedAllocator {
+  static_assert(std::has_single_bit(ALIGNMENT), "ALIGNMENT must be a power of two.");
+  static_assert(ALIGNMENT >= alignof(T), "ALIGNMENT must be at least the alignment of T.");
+
+  [[nodiscard]] static constexpr auto uses_huge_pages(size_t bytes) noexcept -> bool {
+    return PAGES != PageKind::DEFAULT && bytes >= detail::HUGE_PAGE_SIZE;
+  }
+  // `calloc` only guarantees the alignment of max_align_t, large blocks with a larger alignment are
+  // mapped directly instead
+  [[nodiscard]] static constexpr auto uses_mapping(size_t bytes) noexcept -> bool {
+    return ALIGNMENT > alignof(std::max_align_t) && ALIGNMENT <= detail::MIN_PAGE_SIZE &&
+           bytes >= detail::MAPPING_THRESHOLD;
+  }
+
+ public:
+  using value_type = T;
+
+  static constexpr size_t alignment = ALIGNMENT;
+  static constexpr PageKind pages   = PAGES;
+
+  template <typename U>
+  struct rebind {
+    using other = AlignedAllocator<U, std::max(ALIGNMENT, alignof(U)), PAGES>;
+  };
+
+  constexpr AlignedAllocator() noexcept = default;
+  template <typename U, size_t OTHER_ALIGNMENT>
+  constexpr AlignedAllocator(
+      const AlignedAllocator<U, OTHER_ALIGNMENT, PAGES>& /*other*/) noexcept {}
+
+  [[nodiscard]] auto allocate(size_t n) -> T* {
+    const size_t bytes = n * sizeof(T);
+    if (uses_huge_pages(bytes)) {
+      const size_t mapped_bytes = detail::round_up(bytes, detail::HUGE_PAGE_SIZE);
+      void* data                = nullptr;
+      if constexpr (PAGES == PageKind::EXPLICIT_HUGE) {
+        data = detail::map_explicit_huge(mapped_bytes);
+      }
+      if (data == nullptr) { data = detail::map_transparent_huge(mapped_bytes); }
+      if (data == nullptr) { throw std::bad_alloc{}; }
+      return static_cast<T*>(data);
+    }
+    if (uses_mapping(bytes)) {
+      void* data = mmap(nullptr,
+                        detail::round_up(bytes, detail::MIN_PAGE_SIZE),
+                        PROT_READ | PROT_WRITE,
+                        MAP_PRIVATE | MAP_ANONYMOUS,
+                        -1,
+                        0);
+      if (data == MAP_FAILED) { throw std::bad_alloc{}; }
+      return static_cast<T*>(data);
+    }
+
+    // `aligned_alloc` requires the size to be a multiple of the alignment
+    void* data = std::aligned_alloc(ALIGNMENT, detail::round_up(std::max(bytes, 1UZ), ALIGNMENT));
+    if (data == nullptr) { throw std::bad_alloc{}; }
+    return static_cast<T*>(data);
+  }
+
+  // Allocate zero-initialized memory; large blocks come from fresh anonymous mappings (directly or
+  // via `calloc`) s.t. the pages are only zeroed and backed by memory when first touched.
+  [[nodiscard]] auto allocate_zeroed(size_t n) -> T* {
+    const size_t bytes = n * sizeof(T);
+    if (uses_huge_pages(bytes) || uses_mapping(bytes)) { return allocate(n); }
+
+    if constexpr (ALIGNMENT <= alignof(std::max_align_t)) {
+      void* data = std::calloc(std::max(n, 1UZ), sizeof(T));  // NOLINT(cppcoreguidelines-no-malloc)
+      if (data == nullptr) { throw std::bad_alloc{}; }
+      return static_cast<T*>(data);
+    } else {
+      T* data = allocate(n);
+      std::memset(static_cast<void*>(data), 0, bytes);
+      return data;
+    }
+  }
+
+  void deallocate(T* data, size_t n) noexcept {
+    const size_t bytes = n * sizeof(T);
+    if (uses_huge_pages(bytes)) {
+      munmap(data, detail::round_up(bytes, detail::HUGE_PAGE_SIZE));
+    } else if (uses_mapping(bytes)) {
+      munmap(data, detail::round_up(bytes, detail::MIN_PAGE_SIZE));
+    } else {
+      std::free(data);  // NOLINT(cppcoreguidelines-no-malloc)
+    }
+  }
+
+  template <typename U, size_t OTHER_ALIGNMENT, PageKind OTHER_PAGES>
+  constexpr auto
+  operator==(const AlignedAllocator<U, OTHER_ALIGNMENT, OTHER_PAGES>& /*other*/) const noexcept
+      -> bool {
+    return ALIGNMENT == OTHER_ALIGNMENT && PAGES == OTHER_PAGES;
+  }
+};
+
+// -------------------------------------------------------------------------------------------------
+// Bump allocator for temporaries with a common lifetime, e.g. the fields of one time step.
+// Deallocation is a no-op, `reset()` makes the whole arena available again without returning the
+// memory to the upstream resource. Not thread-safe.
+class ArenaResource final : public std::pmr::memory_resource {
+  struct Chunk {
+    std::byte* data;
+    size_t size;
+    size_t alignment;
+  };
+
+  static constexpr size_t CHUNK_ALIGNMENT = 64UZ;
+
+  std::pmr::memory_resource* m_upstream;
+  size_t m_next_chunk_size;
+  std::vector<Chunk> m_chunks{};
+  size_t m_current_chunk = 0;
+  size_t m_offset        = 0;
+
+ public:
+  explicit ArenaResource(size_t initial_size,
+                         std::pmr::memory_resource* upstream = std::pmr::get_default_resource())
+      : m_upstream(upstream),
+        m_next_chunk_size(std::max(initial_size, CHUNK_ALIGNMENT)) {}
+
+  ArenaResource(const ArenaResource& other)                    = delete;
+  ArenaResource(ArenaResource&& other)                         = delete;
+  auto operator=(const ArenaResource& other) -> ArenaResource& = delete;
+  auto operator=(ArenaResource&& other) -> ArenaResource&      = delete;
+  ~ArenaResource() noexcept override { release(); }
+
+  // Make all memory available again, all memory allocated from the arena becomes invalid.
+  void reset() noexcept {
+    m_current_chunk = 0;
+    m_offset        = 0;
+  }
+
+  // Return all memory to the upstream resource.
+  void release() noexcept {
+    for (const auto& chunk : m_chunks) {
+      m_upstream->deallocate(chunk.data, chunk.size, chunk.alignment);
+    }
+    m_chunks.clear();
+    reset();
+  }
+
+  [[nodiscard]] auto capacity() const noexcept -> size_t {
+    size_t res = 0;
+    for (const auto& chunk : m_chunks) {
+      res += chunk.size;
+    }
+    return res;
+  }
+
+ private:
+  auto do_allocate(size_t bytes, size_t alignment) -> void* override {
+    for (; m_current_chunk < m_chunks.size(); ++m_current_chunk, m_offset = 0) {
+      // Round the address instead of the offset, the chunk might be less aligned than requested
+      const Chunk& chunk  = m_chunks[m_current_chunk];
+      const auto begin    = reinterpret_cast<std::uintptr_t>(chunk.data);  // NOLINT
+      const size_t offset = detail::round_up(begin + m_offset, alignment) - begin;
+      if (offset + bytes <= chunk.size) {
+        m_offset = offset + bytes;
+        return chunk.data + offset;  // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+      }
+    }
+
+    // No chunk has enough space left, add a chunk that is at least twice as large as the last one
+    const size_t chunk_size      = std::max(m_next_chunk_size, detail::round_up(bytes, alignment));
+    const size_t chunk_alignment = std::max(alignment, CHUNK_ALIGNMENT);
+    auto* data                   = static_cast<std::byte*>(
+        m_upstream->allocate(chunk_size, chunk_alignment));
+    m_chunks.push_back(Chunk{.data = data, .size = chunk_size, .alignment = chunk_alignment});
+    m_next_chunk_size = 2UZ * chunk_size;
+    m_current_chunk   = m_chunks.size() - 1UZ;
+    m_offset          = bytes;
+    return data;
+  }
+
+  void do_deallocate(void* /*p*/, size_t /*bytes*/, size_t /*alignment*/) noexcept override {}
+
+  [[nodiscard]] auto do_is_equal(const std::pmr::memory_resource& other) const noexcept
+      -> bool override {
+    return this == &other;
+  }
+};
+
+// -------------------------------------------------------------------------------------------------
+// Pool that caches deallocated blocks in size classes and hands them out again instead of returning
+// them to the upstream resource. Every power of two is split into four size classes s.t. at most
+// 25% of a block are wasted. Blocks are only returned upstream by `release()` or on destruction.
+// Not thread-safe.
+class PoolResource final : public std::pmr::memory_resource {
+  struct FreeList {
+    size_t block_size;
+    size_t alignment;
+    std::vector<void*> blocks;
+  };
+
+  static constexpr size_t MIN_BLOCK_SIZE = 64UZ;
+  static constexpr size_t MIN_ALIGNMENT  = 64UZ;
+
+  std::pmr::memory_resource* m_upstream;
+  std::vector<FreeList> m_free_lists{};
+
+  [[nodiscard]] static constexpr auto size_class(size_t bytes) noexcept -> size_t {
+    if (bytes <= MIN_BLOCK_SIZE) { return MIN_BLOCK_SIZE; }
+    const auto step = size_t{1} << (std::bit_width(bytes - 1UZ) - 3);
+    return detail::round_up(bytes, step);
+  }
+
+  [[nodiscard]] auto free_list(size_t block_size, size_t alignment) -> FreeList& {
+    for (auto& list : m_free_lists) {
+      if (list.block_size == block_size && list.alignment == alignment) { return list; }
+    }
+    return m_free_lists.emplace_back(
+        FreeList{.block_size = block_size, .alignment = alignment, .blocks = {}});
+  }
+
+ public:
+  explicit PoolResource(std::pmr::memory_resource* upstream = std::pmr::get_default_resource())
+      : m_upstream(upstream) {}
+
+  PoolResource(const PoolResource& other)                    = delete;
+  PoolResource(PoolResource&& other)                         = delete;
+  auto operator=(const PoolResource& other) -> PoolResource& = delete;
+  auto operator=(PoolResource&& other) -> PoolResource&      = delete;
+  ~PoolResource() noexcept override { release(); }
+
+  // Return all cached blocks to the upstream resource.
+  void release() noexcept {
+    for (auto& list : m_free_lists) {
+      for (void* block : list.blocks) {
+        m_upstream->deallocate(block, list.block_size, list.alignment);
+      }
+      list.blocks.clear();
+    }
+  }
+
+  [[nodiscard]] auto num_cached_blocks() const noexcept -> size_t {
+    size_t res = 0;
+    for (const auto& list : m_free_lists) {
+      res += list.blocks.size();
+    }
+    return res;
+  }
+
+ private:
+  auto do_allocate(size_t bytes, size_t alignment) -> void* override {
+    alignment      = std::max(alignment, MIN_ALIGNMENT);
+    FreeList& list = free_list(size_class(bytes), alignment);
+    if (!list.blocks.empty()) {
+      void* block = list.blocks.back();
+      list.blocks.pop_back();
+      return block;
+    }
+    return m_upstream->allocate(list.block_size, alignment);
+  }
+
+  void do_deallocate(void* p, size_t bytes, size_t alignment) override {
+    free_list(size_class(bytes), std::max(alignment, MIN_ALIGNMENT)).blocks.push_back(p);
+  }
+
+  [[nodiscard]] auto do_is_equal(const std::pmr::memory_resource& other) const noexcept
+      -> bool override {
+    return this == &other;
+  }
+};
+
+}  // namespace Igor
+
+#endif  // IGOR_ALLOCATOR_HPP_
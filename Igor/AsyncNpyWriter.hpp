@@ -0,0 +1,256 @@
+#ifndef IGOR_ASYNC_NPY_WRITER_HPP_
+#define IGOR_ASYNC_NPY_WRITER_HPP_
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <future>
+#include <mdspan>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <Igor/ForEachIndex.hpp>
+#include <Igor/Logging.hpp>
+#include <Igor/MdAccessor.hpp>
+#include <Igor/MdArray.hpp>
+#include <Igor/MdspanToNpy.hpp>
+#include <Igor/Parallel.hpp>
+#include <Igor/ReducedPrecision.hpp>
+
+namespace Igor {
+
+// -------------------------------------------------------------------------------------------------
+// Writes npy snapshots on a background I/O thread s.t. the caller only pays for a copy into memory.
+// `write(span, filename)` copies the elements in parallel into one of `n_buffers` staging buffers,
+// `write(std::move(array), filename)` takes ownership of an MdArray without copying. Both return
+// immediately with a future for the result of `mdspan_to_npy`. At most `n_buffers` snapshots are in
+// flight, further writes block until the oldest one is on disk. The staging buffers are kept and
+// reused by later snapshots, i.e. memory is only allocated for the first snapshots (or when a
+// snapshot outgrows a buffer). The destructor waits until all snapshots are written.
+class AsyncNpyWriter {
+  struct StagingBuffer {
+    std::unique_ptr<std::byte[]> data;  // NOLINT(cppcoreguidelines-avoid-c-arrays)
+    size_t capacity = 0;
+  };
+
+  struct Job {
+    std::move_only_function<bool(std::byte*)> write;
+    StagingBuffer buffer;
+    std::promise<bool> result;
+  };
+
+  size_t m_n_buffers;
+  std::mutex m_mutex;
+  std::condition_variable m_job_cv;   // Signals new jobs and shutdown to the I/O thread
+  std::condition_variable m_done_cv;  // Signals finished jobs to writers waiting for a slot
+  std::deque<Job> m_jobs;
+  std::vector<StagingBuffer> m_free_buffers;
+  size_t m_in_flight = 0;
+  bool m_stop        = false;
+  std::thread m_io_thread;
+
+  void io_loop() noexcept {
+    for (;;) {
+      Job job{};
+      {
+        std::unique_lock lock(m_mutex);
+        m_job_cv.wait(lock, [&] { return m_stop || !m_jobs.empty(); });
+        if (m_jobs.empty()) { return; }
+        job = std::move(m_jobs.front());
+        m_jobs.pop_front();
+      }
+
+      try {
+        job.result.set_value(job.write(job.buffer.data.get()));
+      } catch (...) {
+        job.result.set_exception(std::current_exception());
+      }
+      job.write = nullptr;  // Release owned arrays before the slot is freed
+
+      if (job.buffer.data != nullptr) {
+        std::lock_guard lock(m_mutex);
+        m_free_buffers.push_back(std::move(job.buffer));
+      }
+      release_slot();
+    }
+  }
+
+  // Wait until less than `n_buffers` snapshots are in flight and reserve a slot
+  void acquire_slot() noexcept {
+    std::unique_lock lock(m_mutex);
+    m_done_cv.wait(lock, [&] { return m_in_flight < m_n_buffers; });
+    m_in_flight += 1UZ;
+  }
+  void release_slot() noexcept {
+    {
+      std::lock_guard lock(m_mutex);
+      m_in_flight -= 1UZ;
+    }
+    m_done_cv.notify_all();
+  }
+
+  // Staging buffer of at least `bytes` bytes, reuses the smallest free buffer that is large enough,
+  // otherwise replaces the largest one
+  [[nodiscard]] auto take_buffer(size_t bytes) -> StagingBuffer {
+    StagingBuffer buffer{};
+    {
+      std::lock_guard lock(m_mutex);
+      auto best = m_free_buffers.end();
+      for (auto it = m_free_buffers.begin(); it != m_free_buffers.end(); ++it) {
+        if (it->capacity >= bytes &&
+            (best == m_free_buffers.end() || it->capacity < best->capacity)) {
+          best = it;
+        }
+      }
+      if (best == m_free_buffers.end() && !m_free_buffers.empty()) {
+        best = std::ranges::max_element(m_free_buffers, {}, &StagingBuffer::capacity);
+      }
+      if (best != m_free_buffers.end()) {
+        buffer = std::move(*best);
+        m_free_buffers.erase(best);
+      }
+    }
+
+    if (buffer.capacity < bytes) {
+      buffer.data.reset();
+      buffer.data     = std::make_unique_for_overwrite<std::byte[]>(bytes);  // NOLINT
+      buffer.capacity = bytes;
+    }
+    return buffer;
+  }
+
+  [[nodiscard]] auto submit(std::move_only_function<bool(std::byte*)> write, StagingBuffer buffer)
+      -> std::future<bool> {
+    Job job{.write = std::move(write), .buffer = std::move(buffer), .result = {}};
+    auto result = job.result.get_future();
+    {
+      std::lock_guard lock(m_mutex);
+      m_jobs.push_back(std::move(job));
+    }
+    m_job_cv.notify_one();
+    return result;
+  }
+
+ public:
+  explicit AsyncNpyWriter(size_t n_buffers = 2UZ)
+      : m_n_buffers(std::max(n_buffers, 1UZ)),
+        m_io_thread(&AsyncNpyWriter::io_loop, this) {}
+
+  AsyncNpyWriter(const AsyncNpyWriter&)                    = delete;
+  AsyncNpyWriter(AsyncNpyWriter&&)                         = delete;
+  auto operator=(const AsyncNpyWriter&) -> AsyncNpyWriter& = delete;
+  auto operator=(AsyncNpyWriter&&) -> AsyncNpyWriter&      = delete;
+  ~AsyncNpyWriter() noexcept {
+    {
+      std::lock_guard lock(m_mutex);
+      m_stop = true;
+    }
+    m_job_cv.notify_one();
+    m_io_thread.join();
+  }
+
+  [[nodiscard]] constexpr auto n_buffers() const noexcept -> size_t { return m_n_buffers; }
+
+  // Number of snapshots that are not completely written yet
+  [[nodiscard]] auto in_flight() noexcept -> size_t {
+    std::lock_guard lock(m_mutex);
+    return m_in_flight;
+  }
+
+  // Block until all snapshots are written
+  void wait() noexcept {
+    std::unique_lock lock(m_mutex);
+    m_done_cv.wait(lock, [&] { return m_in_flight == 0UZ; });
+  }
+
+  // -----------------------------------------------------------------------------------------------
+  // Copy the elements of `data` into a staging buffer with `n_threads` threads and write them to
+  // `filename` in the background. Layouts other than layout_left are staged in C order; elements
+  // are staged as the type written to the file, i.e. float16 storage as is and other proxy
+  // references like bfloat16 elements converted to their value type.
+  template <typename E, typename X, typename L, typename A>
+  [[nodiscard]] auto write(const std::mdspan<E, X, L, A>& data,
+                           std::string filename,
+                           size_t n_threads = num_threads()) -> std::future<bool> {
+    using Value  = detail::npy_value_t<E, A>;
+    using Layout = std::conditional_t<std::is_same_v<L, std::layout_left>,
+                                      std::layout_left,
+                                      std::layout_right>;
+    using Staged = std::mdspan<Value, X, Layout>;
+    static_assert(std::is_trivially_copyable_v<Value>, "Element type must be trivially copyable.");
+    static_assert(alignof(Value) <= __STDCPP_DEFAULT_NEW_ALIGNMENT__,
+                  "Element type is over-aligned for the staging buffers.");
+
+    acquire_slot();
+    StagingBuffer buffer{};
+    try {
+      buffer = take_buffer(std::max(data.size() * sizeof(Value), 1UZ));
+    } catch (...) {
+      release_slot();
+      throw;
+    }
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+    const Staged staged(reinterpret_cast<Value*>(buffer.data.get()), data.extents());
+    constexpr bool raw_half = std::is_same_v<Value, float16>;
+    if constexpr (std::is_same_v<L, Layout> &&
+                  (raw_half || detail::has_plain_accessor<std::mdspan<E, X, L, A>>)) {
+      const size_t n = data.size();
+      n_threads      = std::clamp(n_threads, 1UZ, std::max(n, 1UZ));
+      parallel_for(
+          0UZ,
+          n_threads,
+          [&](size_t thread_id) {
+            const auto [begin, end] = detail::static_chunk(0UZ, n, thread_id, n_threads);
+            // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+            std::copy(data.data_handle() + begin,
+                      data.data_handle() + end,
+                      staged.data_handle() + begin);
+          },
+          n_threads);
+    } else if constexpr (raw_half) {
+      parallel_for_index(
+          staged,
+          [&](auto... idx) { staged[idx...] = from_float<float16>(data[idx...]); },
+          n_threads);
+    } else {
+      parallel_for_index(
+          staged, [&](auto... idx) { staged[idx...] = data[idx...]; }, n_threads);
+    }
+
+    return submit(
+        [extents = data.extents(), filename = std::move(filename)](std::byte* bytes) {
+          // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+          const std::mdspan<const Value, X, Layout> view(reinterpret_cast<const Value*>(bytes),
+                                                         extents);
+          return mdspan_to_npy(view, filename);
+        },
+        std::move(buffer));
+  }
+
+  // -----------------------------------------------------------------------------------------------
+  // Take ownership of `data` and write it to `filename` in the background, `data` is destroyed on
+  // the I/O thread afterwards
+  template <typename E, typename X, typename L, typename A, typename Alloc>
+  [[nodiscard]] auto write(MdArray<E, X, L, A, Alloc>&& data, std::string filename)
+      -> std::future<bool> {
+    acquire_slot();
+    return submit(
+        [data = std::move(data), filename = std::move(filename)](std::byte* /*bytes*/) {
+          return mdspan_to_npy(data, filename);
+        },
+        {});
+  }
+};
+
+}  // namespace Igor
+
+#endif  // IGOR_ASYNC_NPY_WRITER_HPP_
@@ -0,0 +1,313 @@
+#ifndef IGOR_BIT_MD_ARRAY_HPP_
+#define IGOR_BIT_MD_ARRAY_HPP_
+
+#include <array>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <mdspan>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include <Igor/Logging.hpp>
+#include <Igor/MdArray.hpp>
+#include <Igor/Reduce.hpp>
+
+namespace Igor {
+
+// =================================================================================================
+// Boolean masks with one bit per element, e.g. fluid/solid or refinement flags. `bit_accessor`
+// reads and writes single bits through a proxy reference, `BitMdArray` owns the words and provides
+// word-parallel reductions, bitwise operations and iteration over the set bits.
+// Writing bits is a read-modify-write of the whole word, i.e. threads must not write elements that
+// share a word concurrently.
+// =================================================================================================
+
+namespace detail {
+
+using BitWord                          = std::uint64_t;
+inline constexpr size_t BITS_PER_WORD  = std::numeric_limits<BitWord>::digits;
+inline constexpr BitWord ALL_BITS_WORD = ~BitWord{0};
+
+[[nodiscard]] constexpr auto num_bit_words(size_t bits) noexcept -> size_t {
+  return (bits + BITS_PER_WORD - 1UZ) / BITS_PER_WORD;
+}
+
+}  // namespace detail
+
+// -------------------------------------------------------------------------------------------------
+// Data handle of a `bit_accessor`, bit `offset` of the array `words`
+template <typename Word>
+requires std::same_as<std::remove_const_t<Word>, detail::BitWord>
+struct BitPointer {
+  Word* words   = nullptr;
+  size_t offset = 0;
+
+  constexpr BitPointer() noexcept = default;
+  constexpr BitPointer(Word* w, size_t o) noexcept
+      : words(w),
+        offset(o) {}
+  template <typename OtherWord>
+  requires(std::is_convertible_v<OtherWord*, Word*>)
+  constexpr BitPointer(BitPointer<OtherWord> other) noexcept  // NOLINT
+      : words(other.words),
+        offset(other.offset) {}
+};
+
+// -------------------------------------------------------------------------------------------------
+// Reference to a single bit that behaves like a bool reference
+class BitRef {
+  detail::BitWord* m_word;
+  detail::BitWord m_mask;
+
+ public:
+  constexpr BitRef(detail::BitWord* word, detail::BitWord mask) noexcept
+      : m_word(word),
+        m_mask(mask) {}
+
+  constexpr operator bool() const noexcept { return (*m_word & m_mask) != 0U; }
+
+  constexpr auto operator=(bool value) const noexcept -> const BitRef& {
+    *m_word = value ? (*m_word | m_mask) : (*m_word & ~m_mask);
+    return *this;
+  }
+  constexpr auto operator=(const BitRef& other) const noexcept -> const BitRef& {
+    return *this = static_cast<bool>(other);
+  }
+  constexpr auto operator|=(bool value) const noexcept -> const BitRef& {
+    if (value) { *m_word |= m_mask; }
+    return *this;
+  }
+  constexpr auto operator&=(bool value) const noexcept -> const BitRef& {
+    if (!value) { *m_word &= ~m_mask; }
+    return *this;
+  }
+  constexpr auto operator^=(bool value) const noexcept -> const BitRef& {
+    if (value) { *m_word ^= m_mask; }
+    return *this;
+  }
+  constexpr void flip() const noexcept { *m_word ^= m_mask; }
+};
+
+// -------------------------------------------------------------------------------------------------
+// Accessor for bit-packed booleans, a const bool element type gives read-only access.
+template <typename ElementType>
+requires std::same_as<std::remove_const_t<ElementType>, bool>
+struct bit_accessor {
+  using offset_policy = bit_accessor;
+  using element_type  = ElementType;
+  using word_type =
+      std::conditional_t<std::is_const_v<ElementType>, const detail::BitWord, detail::BitWord>;
+  using reference        = std::conditional_t<std::is_const_v<ElementType>, bool, BitRef>;
+  using data_handle_type = BitPointer<word_type>;
+
+  constexpr bit_accessor() noexcept = default;
+
+  template <typename OtherElementType>
+  requires(std::is_convertible_v<OtherElementType (*)[], ElementType (*)[]>)  // NOLINT
+  constexpr bit_accessor(bit_accessor<OtherElementType> /*other*/) noexcept {}
+
+  [[nodiscard]] constexpr auto access(data_handle_type p, size_t i) const noexcept -> reference {
+    const size_t bit           = p.offset + i;
+    const detail::BitWord mask = detail::BitWord{1} << (bit % detail::BITS_PER_WORD);
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    word_type* word = p.words + bit / detail::BITS_PER_WORD;
+    if constexpr (std::is_const_v<ElementType>) {
+      return (*word & mask) != 0U;
+    } else {
+      return reference(word, mask);
+    }
+  }
+
+  [[nodiscard]] constexpr auto offset(data_handle_type p, size_t i) const noexcept
+      -> data_handle_type {
+    return {p.words, p.offset + i};
+  }
+};
+
+namespace detail {
+
+// Words of a `BitMdArray`, a base class s.t. it is constructed before the mdspan that uses it
+struct BitBuffer {
+  MdArray<BitWord, std::dextents<size_t, 1>> m_words;
+};
+
+}  // namespace detail
+
+// -------------------------------------------------------------------------------------------------
+// Owning bit-packed boolean array, all elements are initially false. Bit k of the buffer is the
+// element at offset k of the layout mapping, the bits after the last element are always zero.
+template <typename Extents, typename LayoutPolicy = std::layout_right>
+class BitMdArray : private detail::BitBuffer,
+                   public std::mdspan<bool, Extents, LayoutPolicy, bit_accessor<bool>> {
+  using Base = std::mdspan<bool, Extents, LayoutPolicy, bit_accessor<bool>>;
+  static_assert(std::is_same_v<LayoutPolicy, std::layout_right> ||
+                    std::is_same_v<LayoutPolicy, std::layout_left>,
+                "BitMdArray requires layout_right or layout_left.");
+
+  constexpr explicit BitMdArray(detail::BitBuffer buffer, const Extents& extents)
+      : detail::BitBuffer(std::move(buffer)),
+        Base(BitPointer(m_words.get_data(), 0UZ), extents) {}
+
+  // Reset the bits after the last element, they must stay zero for the word-parallel operations
+  constexpr void clear_tail() noexcept {
+    if (const size_t tail = this->size() % detail::BITS_PER_WORD; tail != 0UZ) {
+      m_words[num_words() - 1UZ] &= (detail::BitWord{1} << tail) - 1U;
+    }
+  }
+
+  // Multi-index of the element at offset `k`
+  [[nodiscard]] constexpr auto unravel(size_t k) const noexcept
+      -> std::array<typename Extents::index_type, Extents::rank()> {
+    std::array<typename Extents::index_type, Extents::rank()> idx{};
+    for (size_t i = 0; i < Extents::rank(); ++i) {
+      const size_t r = std::is_same_v<LayoutPolicy, std::layout_left> ? i : Extents::rank() - 1 - i;
+      const auto n   = static_cast<size_t>(this->extent(r));
+      idx[r]         = static_cast<typename Extents::index_type>(k % n);
+      k /= n;
+    }
+    return idx;
+  }
+
+  template <typename F>
+  constexpr void combine(const BitMdArray& other, F&& op) noexcept {
+    IGOR_ASSERT(this->extents() == other.extents(), "Extents of the masks do not match.");
+    for (size_t w = 0; w < num_words(); ++w) {
+      m_words[w] = op(m_words[w], other.m_words[w]);
+    }
+  }
+
+ public:
+  using word_type = detail::BitWord;
+
+  template <typename... Sizes>
+  requires(std::is_convertible_v<std::remove_cvref_t<Sizes>, typename Extents::size_type> && ...)
+  constexpr BitMdArray(Sizes... n)
+      : BitMdArray(detail::BitBuffer{MdArray<word_type, std::dextents<size_t, 1>>(
+                       zero_init,
+                       detail::num_bit_words(
+                           static_cast<size_t>(typename Base::mapping_type(Extents(n...))
+                                                   .required_span_size())))},
+                   Extents(n...)) {}
+
+  constexpr BitMdArray(const BitMdArray& other) noexcept                    = delete;
+  constexpr auto operator=(const BitMdArray& other) noexcept -> BitMdArray& = delete;
+  constexpr BitMdArray(BitMdArray&& other) noexcept                         = default;
+  constexpr auto operator=(BitMdArray&& other) noexcept -> BitMdArray&      = default;
+  constexpr ~BitMdArray() noexcept                                          = default;
+
+  [[nodiscard]] auto clone() const -> BitMdArray {
+    return BitMdArray(detail::BitBuffer{m_words.clone()}, this->extents());
+  }
+
+  [[nodiscard]] constexpr auto get_data() noexcept -> word_type* { return m_words.get_data(); }
+  [[nodiscard]] constexpr auto get_data() const noexcept -> const word_type* {
+    return m_words.get_data();
+  }
+  [[nodiscard]] constexpr auto num_words() const noexcept -> size_t { return m_words.size(); }
+
+  // -----------------------------------------------------------------------------------------------
+  // Number of set elements, the words are optionally split over `n_threads` threads
+  [[nodiscard]] auto count(size_t n_threads = 1UZ) const noexcept -> size_t {
+    return detail::parallel_reduce<detail::SumOp<size_t>, size_t>(
+        num_words(), n_threads, [&](size_t begin, size_t end) {
+          size_t n = 0;
+          for (size_t w = begin; w < end; ++w) {
+            n += static_cast<size_t>(std::popcount(m_words[w]));
+          }
+          return n;
+        });
+  }
+
+  [[nodiscard]] constexpr auto any() const noexcept -> bool {
+    for (size_t w = 0; w < num_words(); ++w) {
+      if (m_words[w] != 0U) { return true; }
+    }
+    return false;
+  }
+  [[nodiscard]] constexpr auto none() const noexcept -> bool { return !any(); }
+  [[nodiscard]] constexpr auto all() const noexcept -> bool {
+    const size_t full_words = this->size() / detail::BITS_PER_WORD;
+    for (size_t w = 0; w < full_words; ++w) {
+      if (m_words[w] != detail::ALL_BITS_WORD) { return false; }
+    }
+    const size_t tail = this->size() % detail::BITS_PER_WORD;
+    return tail == 0UZ || m_words[full_words] == (detail::BitWord{1} << tail) - 1U;
+  }
+
+  // -----------------------------------------------------------------------------------------------
+  void fill(bool value) {
+    m_words.fill(value ? detail::ALL_BITS_WORD : detail::BitWord{0});
+    clear_tail();
+  }
+
+  constexpr void flip() noexcept {
+    for (size_t w = 0; w < num_words(); ++w) {
+      m_words[w] = ~m_words[w];
+    }
+    clear_tail();
+  }
+
+  constexpr auto operator&=(const BitMdArray& other) noexcept -> BitMdArray& {
+    combine(other, [](word_type a, word_type b) { return a & b; });
+    return *this;
+  }
+  constexpr auto operator|=(const BitMdArray& other) noexcept -> BitMdArray& {
+    combine(other, [](word_type a, word_type b) { return a | b; });
+    return *this;
+  }
+  constexpr auto operator^=(const BitMdArray& other) noexcept -> BitMdArray& {
+    combine(other, [](word_type a, word_type b) { return a ^ b; });
+    return *this;
+  }
+  // Clear all elements that are set in `other`
+  constexpr auto and_not(const BitMdArray& other) noexcept -> BitMdArray& {
+    combine(other, [](word_type a, word_type b) { return a & ~b; });
+    return *this;
+  }
+
+  // -----------------------------------------------------------------------------------------------
+  // Call `f(i, j, ...)` for the multi-indices of all set elements in memory order, skips zero words
+  // and extracts the set bits of a word with count-trailing-zeros.
+  template <typename F>
+  constexpr void for_each_set(F&& f) const {
+    for (size_t w = 0; w < num_words(); ++w) {
+      for (word_type word = m_words[w]; word != 0U; word &= word - 1U) {
+        const auto bit = static_cast<size_t>(std::countr_zero(word));
+        std::apply(f, unravel(w * detail::BITS_PER_WORD + bit));
+      }
+    }
+  }
+};
+
+template <typename Extents, typename LayoutPolicy>
+[[nodiscard]] auto operator&(const BitMdArray<Extents, LayoutPolicy>& a,
+                             const BitMdArray<Extents, LayoutPolicy>& b)
+    -> BitMdArray<Extents, LayoutPolicy> {
+  auto res = a.clone();
+  res &= b;
+  return res;
+}
+template <typename Extents, typename LayoutPolicy>
+[[nodiscard]] auto operator|(const BitMdArray<Extents, LayoutPolicy>& a,
+                             const BitMdArray<Extents, LayoutPolicy>& b)
+    -> BitMdArray<Extents, LayoutPolicy> {
+  auto res = a.clone();
+  res |= b;
+  return res;
+}
+template <typename Extents, typename LayoutPolicy>
+[[nodiscard]] auto operator^(const BitMdArray<Extents, LayoutPolicy>& a,
+                             const BitMdArray<Extents, LayoutPolicy>& b)
+    -> BitMdArray<Extents, LayoutPolicy> {
+  auto res = a.clone();
+  res ^= b;
+  return res;
+}
+
+}  // namespace Igor
+
+#endif  // IGOR_BIT_MD_ARRAY_HPP_
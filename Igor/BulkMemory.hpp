@@ -0,0 +1,194 @@
+#ifndef IGOR_BULK_MEMORY_HPP_
+#define IGOR_BULK_MEMORY_HPP_
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+#if defined(__SSE2__)
+#include <immintrin.h>
+#endif  // __SSE2__
+
+#include <Igor/Parallel.hpp>
+
+namespace Igor {
+
+namespace detail {
+
+// Below this size the work is not split over threads
+inline constexpr size_t PARALLEL_THRESHOLD_BYTES = 1UZ << 20UZ;
+// Starting at this size the destination is written with non-temporal stores that bypass the cache,
+// the data would evict the whole last level cache anyway
+inline constexpr size_t STREAMING_THRESHOLD_BYTES = 1UZ << 24UZ;
+
+#if defined(__AVX__)
+using StreamVector = __m256i;
+#elif defined(__SSE2__)
+using StreamVector = __m128i;
+#endif  // __AVX__
+
+#if defined(__SSE2__)
+inline void stream_store(std::byte* dst, StreamVector v) noexcept {
+  // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+  auto* vdst = reinterpret_cast<StreamVector*>(dst);
+#if defined(__AVX__)
+  _mm256_stream_si256(vdst, v);
+#else
+  _mm_stream_si128(vdst, v);
+#endif  // __AVX__
+}
+
+[[nodiscard]] inline auto unaligned_load(const std::byte* src) noexcept -> StreamVector {
+  // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+  const auto* vsrc = reinterpret_cast<const StreamVector*>(src);
+#if defined(__AVX__)
+  return _mm256_loadu_si256(vsrc);
+#else
+  return _mm_loadu_si128(vsrc);
+#endif  // __AVX__
+}
+
+// Number of bytes until `ptr` is aligned for a vector store
+[[nodiscard]] inline auto bytes_to_vector_alignment(const std::byte* ptr) noexcept -> size_t {
+  constexpr size_t VEC = sizeof(StreamVector);
+  return (VEC - reinterpret_cast<std::uintptr_t>(ptr) % VEC) % VEC;  // NOLINT
+}
+#endif  // __SSE2__
+
+// NOLINTBEGIN(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+inline void stream_copy_bytes(std::byte* dst, const std::byte* src, size_t bytes) noexcept {
+#if defined(__SSE2__)
+  constexpr size_t VEC = sizeof(StreamVector);
+  const size_t head    = std::min(bytes, bytes_to_vector_alignment(dst));
+  std::memcpy(dst, src, head);
+  dst += head;
+  src += head;
+  bytes -= head;
+
+  const size_t vector_bytes = (bytes / VEC) * VEC;
+  for (size_t i = 0; i < vector_bytes; i += VEC) {
+    stream_store(dst + i, unaligned_load(src + i));
+  }
+  std::memcpy(dst + vector_bytes, src + vector_bytes, bytes - vector_bytes);
+  // Non-temporal stores are weakly ordered, make them visible before other threads read the data
+  _mm_sfence();
+#else
+  std::memcpy(dst, src, bytes);
+#endif  // __SSE2__
+}
+
+template <typename T>
+void stream_fill(T* dst, size_t n, const T& value) noexcept {
+#if defined(__SSE2__)
+  constexpr size_t VEC = sizeof(StreamVector);
+  // The vector must hold a whole number of elements and must be reachable by advancing whole
+  // elements, otherwise the pattern is out of phase
+  if constexpr (VEC % sizeof(T) == 0) {
+    if (reinterpret_cast<std::uintptr_t>(dst) % sizeof(T) == 0) {  // NOLINT
+      auto* bytes_dst   = reinterpret_cast<std::byte*>(dst);          // NOLINT
+      const size_t head = std::min(n, bytes_to_vector_alignment(bytes_dst) / sizeof(T));
+      std::fill_n(dst, head, value);
+      dst += head;
+      n -= head;
+
+      std::array<std::byte, VEC> pattern{};
+      for (size_t i = 0; i < VEC; i += sizeof(T)) {
+        std::memcpy(pattern.data() + i, &value, sizeof(T));
+      }
+      const StreamVector v = unaligned_load(pattern.data());
+
+      constexpr size_t elems_per_vec = VEC / sizeof(T);
+      const size_t vector_elems      = (n / elems_per_vec) * elems_per_vec;
+      bytes_dst                      = reinterpret_cast<std::byte*>(dst);  // NOLINT
+      for (size_t i = 0; i < vector_elems * sizeof(T); i += VEC) {
+        stream_store(bytes_dst + i, v);
+      }
+      std::fill_n(dst + vector_elems, n - vector_elems, value);
+      _mm_sfence();
+      return;
+    }
+  }
+#endif  // __SSE2__
+  std::fill_n(dst, n, value);
+}
+// NOLINTEND(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+
+// Split [0, n) in one contiguous block per thread if the work is large enough. Small work is done
+// on the calling thread and may throw, `f` must not throw if the work can be split.
+template <typename F>
+void for_each_block(size_t n, size_t bytes, F&& f) {
+  const size_t n_threads = bytes < PARALLEL_THRESHOLD_BYTES ? 1UZ : num_threads();
+  if (n_threads == 1UZ) {
+    f(0UZ, n);
+    return;
+  }
+  parallel_for(
+      0UZ,
+      n_threads,
+      [&](size_t thread_id) {
+        const auto [begin, end] = static_chunk(0UZ, n, thread_id, n_threads);
+        f(begin, end);
+      },
+      n_threads);
+}
+
+}  // namespace detail
+
+// -------------------------------------------------------------------------------------------------
+// Copy `n` elements from `src` to the non-overlapping range `dst`. Large copies are split over
+// threads and use non-temporal stores for trivially copyable types. Types whose copy assignment
+// can throw are copied serially s.t. exceptions propagate to the caller.
+template <typename T>
+void parallel_copy_n(const T* src, size_t n, T* dst) {
+  if constexpr (!std::is_nothrow_copy_assignable_v<T>) {
+    std::copy_n(src, n, dst);
+    return;
+  }
+  const size_t bytes = n * sizeof(T);
+  detail::for_each_block(n, bytes, [&](size_t begin, size_t end) {
+    // NOLINTBEGIN(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    if constexpr (std::is_trivially_copyable_v<T>) {
+      if (bytes >= detail::STREAMING_THRESHOLD_BYTES) {
+        detail::stream_copy_bytes(reinterpret_cast<std::byte*>(dst + begin),        // NOLINT
+                                  reinterpret_cast<const std::byte*>(src + begin),  // NOLINT
+                                  (end - begin) * sizeof(T));
+      } else {
+        std::memcpy(dst + begin, src + begin, (end - begin) * sizeof(T));
+      }
+    } else {
+      std::copy(src + begin, src + end, dst + begin);
+    }
+    // NOLINTEND(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+  });
+}
+
+// -------------------------------------------------------------------------------------------------
+// Assign `value` to `n` elements starting at `dst`. Large ranges are split over threads and use
+// non-temporal stores for trivially copyable types. Types whose copy assignment can throw are
+// filled serially s.t. exceptions propagate to the caller.
+template <typename T>
+void parallel_fill_n(T* dst, size_t n, const T& value) {
+  if constexpr (!std::is_nothrow_copy_assignable_v<T>) {
+    std::fill_n(dst, n, value);
+    return;
+  }
+  const size_t bytes = n * sizeof(T);
+  detail::for_each_block(n, bytes, [&](size_t begin, size_t end) {
+    // NOLINTBEGIN(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    if constexpr (std::is_trivially_copyable_v<T>) {
+      if (bytes >= detail::STREAMING_THRESHOLD_BYTES) {
+        detail::stream_fill(dst + begin, end - begin, value);
+        return;
+      }
+    }
+    std::fill(dst + begin, dst + end, value);
+    // NOLINTEND(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+  });
+}
+
+}  // namespace Igor
+
+#endif  // IGOR_BULK_MEMORY_HPP_
@@ -0,0 +1,323 @@
+#ifndef IGOR_FOR_EACH_INDEX_HPP_
+#define IGOR_FOR_EACH_INDEX_HPP_
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <mdspan>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include <Igor/Logging.hpp>
+#include <Igor/Parallel.hpp>
+
+namespace Igor {
+
+// =================================================================================================
+// Iteration over the multi-indices of `std::extents`. The loops are nested s.t. the fastest varying
+// index of the layout is innermost, i.e. layout_left iterates the first index fastest and every
+// other layout the last index. The parallel versions split the slowest varying dimension over the
+// threads of `Igor::parallel_for`.
+// =================================================================================================
+
+namespace detail {
+
+template <typename T>
+struct is_extents : std::false_type {};
+template <typename IndexType, size_t... EXTENTS>
+struct is_extents<std::extents<IndexType, EXTENTS...>> : std::true_type {};
+
+template <typename T>
+concept StdExtents = is_extents<T>::value;
+
+// Iterate the first index fastest
+template <typename LayoutPolicy>
+inline constexpr bool left_order = std::is_same_v<LayoutPolicy, std::layout_left>;
+
+// Dimension that varies slowest in memory for LayoutPolicy
+template <typename LayoutPolicy, size_t RANK>
+inline constexpr size_t outer_dim = left_order<LayoutPolicy> ? RANK - 1UZ : 0UZ;
+
+// Call `f(idx)` for all multi-indices `idx` in the box [begin, end), the loops are nested s.t. the
+// first (LEFT_ORDER) or the last index is innermost.
+template <bool LEFT_ORDER, size_t DEPTH = 0UZ, typename Index, size_t RANK, typename F>
+constexpr void nested_for_box(const std::array<Index, RANK>& begin,
+                              const std::array<Index, RANK>& end,
+                              std::array<Index, RANK>& idx,
+                              F& f) {
+  constexpr size_t dim = LEFT_ORDER ? RANK - 1UZ - DEPTH : DEPTH;
+  for (Index i = begin[dim]; i < end[dim]; ++i) {
+    idx[dim] = i;
+    if constexpr (DEPTH + 1UZ < RANK) {
+      nested_for_box<LEFT_ORDER, DEPTH + 1UZ>(begin, end, idx, f);
+    } else {
+      f(std::as_const(idx));
+    }
+  }
+}
+
+// Call `f(idx)` for all multi-indices `idx` in `extents` with `idx[outer]` in
+// [outer_begin, outer_end), where outer is the slowest varying dimension. The loops are nested s.t.
+// the fastest varying index of a layout_left (LEFT_ORDER) or layout_right mapping is innermost.
+template <bool LEFT_ORDER, typename Extents, typename F>
+constexpr void nested_for(const Extents& extents,
+                          std::array<typename Extents::index_type, Extents::rank()>& idx,
+                          size_t outer_begin,
+                          size_t outer_end,
+                          F& f) {
+  using index_type      = typename Extents::index_type;
+  constexpr size_t rank = Extents::rank();
+  constexpr size_t dim  = LEFT_ORDER ? rank - 1UZ : 0UZ;
+  std::array<index_type, rank> begin{};
+  std::array<index_type, rank> end{};
+  for (size_t r = 0; r < rank; ++r) {
+    end[r] = extents.extent(r);
+  }
+  begin[dim] = static_cast<index_type>(outer_begin);
+  end[dim]   = static_cast<index_type>(outer_end);
+  nested_for_box<LEFT_ORDER>(begin, end, idx, f);
+}
+
+}  // namespace detail
+
+// -------------------------------------------------------------------------------------------------
+// Call `f(i, j, ...)` for all multi-indices in `extents` in the loop order of LayoutPolicy
+template <typename LayoutPolicy = std::layout_right, detail::StdExtents Extents, typename F>
+constexpr void for_each_index(const Extents& extents, F&& f) {
+  if constexpr (Extents::rank() == 0) {
+    f();
+  } else {
+    auto call = [&](const auto& idx) { std::apply(f, idx); };
+    std::array<typename Extents::index_type, Extents::rank()> idx{};
+    constexpr size_t outer = detail::outer_dim<LayoutPolicy, Extents::rank()>;
+    detail::nested_for<detail::left_order<LayoutPolicy>>(
+        extents, idx, 0UZ, static_cast<size_t>(extents.extent(outer)), call);
+  }
+}
+
+template <typename E, typename X, typename L, typename A, typename F>
+constexpr void for_each_index(const std::mdspan<E, X, L, A>& span, F&& f) {
+  for_each_index<L>(span.extents(), std::forward<F>(f));
+}
+
+// -------------------------------------------------------------------------------------------------
+// Call `f(i, j, ...)` for all multi-indices in `extents` in the loop order of LayoutPolicy, the
+// slowest varying dimension is split in contiguous blocks over `n_threads` threads. `f` must not
+// throw.
+template <typename LayoutPolicy = std::layout_right, detail::StdExtents Extents, typename F>
+void parallel_for_index(const Extents& extents, F&& f, size_t n_threads = num_threads()) noexcept {
+  if constexpr (Extents::rank() == 0) {
+    f();
+  } else {
+    constexpr size_t outer = detail::outer_dim<LayoutPolicy, Extents::rank()>;
+    const auto n_outer     = static_cast<size_t>(extents.extent(outer));
+    n_threads              = std::clamp(n_threads, 1UZ, std::max(n_outer, 1UZ));
+    parallel_for(
+        0UZ,
+        n_threads,
+        [&](size_t thread_id) {
+          const auto [begin, end] = detail::static_chunk(0UZ, n_outer, thread_id, n_threads);
+          auto call               = [&](const auto& idx) { std::apply(f, idx); };
+          std::array<typename Extents::index_type, Extents::rank()> idx{};
+          detail::nested_for<detail::left_order<LayoutPolicy>>(extents, idx, begin, end, call);
+        },
+        n_threads);
+  }
+}
+
+template <typename E, typename X, typename L, typename A, typename F>
+void parallel_for_index(const std::mdspan<E, X, L, A>& span,
+                        F&& f,
+                        size_t n_threads = num_threads()) noexcept {
+  parallel_for_index<L>(span.extents(), std::forward<F>(f), n_threads);
+}
+
+// -------------------------------------------------------------------------------------------------
+// Box [begin, end) of multi-indices, the unit of work of `for_each_tile`
+template <typename Extents, typename LayoutPolicy = std::layout_right>
+class IndexTile {
+ public:
+  using index_type             = typename Extents::index_type;
+  using layout_type            = LayoutPolicy;
+  static constexpr size_t RANK = Extents::rank();
+  using index_array            = std::array<index_type, RANK>;
+
+ private:
+  Extents m_extents;
+  index_array m_begin;
+  index_array m_end;
+
+ public:
+  constexpr IndexTile(const Extents& extents,
+                      const index_array& begin,
+                      const index_array& end) noexcept
+      : m_extents(extents),
+        m_begin(begin),
+        m_end(end) {}
+
+  [[nodiscard]] static constexpr auto rank() noexcept -> size_t { return RANK; }
+  [[nodiscard]] constexpr auto begin(size_t r) const noexcept -> index_type { return m_begin[r]; }
+  [[nodiscard]] constexpr auto end(size_t r) const noexcept -> index_type { return m_end[r]; }
+  [[nodiscard]] constexpr auto extent(size_t r) const noexcept -> index_type {
+    return m_end[r] - m_begin[r];
+  }
+  [[nodiscard]] constexpr auto size() const noexcept -> size_t {
+    size_t size = 1;
+    for (size_t r = 0; r < RANK; ++r) {
+      size *= static_cast<size_t>(extent(r));
+    }
+    return size;
+  }
+
+  // Call `f(i, j, ...)` for all multi-indices in the tile in the loop order of LayoutPolicy
+  template <typename F>
+  constexpr void for_each(F&& f) const {
+    if constexpr (RANK == 0) {
+      f();
+    } else {
+      auto call = [&](const auto& idx) { std::apply(f, idx); };
+      index_array idx{};
+      detail::nested_for_box<detail::left_order<LayoutPolicy>>(m_begin, m_end, idx, call);
+    }
+  }
+
+  // The tile covers a contiguous range of a layout_left/layout_right mapping if it spans all but
+  // the slowest varying dimension completely; then it can be processed as one linear range
+  [[nodiscard]] constexpr auto is_contiguous() const noexcept -> bool
+  requires(std::is_same_v<LayoutPolicy, std::layout_left> ||
+           std::is_same_v<LayoutPolicy, std::layout_right>)
+  {
+    for (size_t r = 0; r < RANK; ++r) {
+      if (r != detail::outer_dim<LayoutPolicy, RANK> &&
+          (m_begin[r] != 0 || m_end[r] != m_extents.extent(r))) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  // Linear index range [first, last) of a contiguous tile in the mapping of LayoutPolicy
+  [[nodiscard]] constexpr auto linear_range() const noexcept -> std::pair<size_t, size_t>
+  requires(std::is_same_v<LayoutPolicy, std::layout_left> ||
+           std::is_same_v<LayoutPolicy, std::layout_right>)
+  {
+    IGOR_ASSERT(is_contiguous(), "Tile is not contiguous.");
+    const size_t n = size();
+    if (n == 0UZ) { return {0UZ, 0UZ}; }
+    const typename LayoutPolicy::template mapping<Extents> mapping(m_extents);
+    const auto first = static_cast<size_t>(std::apply(mapping, m_begin));
+    return {first, first + n};
+  }
+};
+
+namespace detail {
+
+template <typename Extents>
+[[nodiscard]] constexpr auto num_tiles(const Extents& extents,
+                                       const std::array<size_t, Extents::rank()>& tile_sizes,
+                                       size_t r) noexcept -> size_t {
+  return (static_cast<size_t>(extents.extent(r)) + tile_sizes[r] - 1UZ) / tile_sizes[r];
+}
+
+// Call `f(tile)` for all tiles with a tile index in [outer_tile_begin, outer_tile_end) along the
+// slowest varying dimension
+template <typename LayoutPolicy, typename Extents, typename F>
+void for_each_tile_in(const Extents& extents,
+                      const std::array<size_t, Extents::rank()>& tile_sizes,
+                      size_t outer_tile_begin,
+                      size_t outer_tile_end,
+                      F& f) {
+  using index_type      = typename Extents::index_type;
+  constexpr size_t rank = Extents::rank();
+  constexpr size_t dim  = outer_dim<LayoutPolicy, rank>;
+
+  std::array<size_t, rank> begin{};
+  std::array<size_t, rank> end{};
+  for (size_t r = 0; r < rank; ++r) {
+    end[r] = num_tiles(extents, tile_sizes, r);
+  }
+  begin[dim] = outer_tile_begin;
+  end[dim]   = outer_tile_end;
+
+  auto call_tile = [&](const std::array<size_t, rank>& tile_idx) {
+    std::array<index_type, rank> tile_begin{};
+    std::array<index_type, rank> tile_end{};
+    for (size_t r = 0; r < rank; ++r) {
+      const size_t b = tile_idx[r] * tile_sizes[r];
+      tile_begin[r]  = static_cast<index_type>(b);
+      tile_end[r]    = static_cast<index_type>(
+          std::min(b + tile_sizes[r], static_cast<size_t>(extents.extent(r))));
+    }
+    f(IndexTile<Extents, LayoutPolicy>(extents, tile_begin, tile_end));
+  };
+  std::array<size_t, rank> tile_idx{};
+  nested_for_box<left_order<LayoutPolicy>>(begin, end, tile_idx, call_tile);
+}
+
+}  // namespace detail
+
+// -------------------------------------------------------------------------------------------------
+// Cover `extents` with tiles of size `tile_sizes` (smaller at the upper boundary) and call
+// `f(tile)` with an `IndexTile` for each of them, tiles are visited in the loop order of
+// LayoutPolicy.
+template <typename LayoutPolicy = std::layout_right, detail::StdExtents Extents, typename F>
+void for_each_tile(const Extents& extents,
+                   const std::array<size_t, Extents::rank()>& tile_sizes,
+                   F&& f) {
+  IGOR_ASSERT(std::ranges::all_of(tile_sizes, [](size_t s) { return s > 0UZ; }),
+              "Tile sizes must be positive.");
+  if constexpr (Extents::rank() == 0) {
+    f(IndexTile<Extents, LayoutPolicy>(extents, {}, {}));
+  } else {
+    constexpr size_t outer = detail::outer_dim<LayoutPolicy, Extents::rank()>;
+    detail::for_each_tile_in<LayoutPolicy>(
+        extents, tile_sizes, 0UZ, detail::num_tiles(extents, tile_sizes, outer), f);
+  }
+}
+
+template <typename E, typename X, typename L, typename A, typename F>
+void for_each_tile(const std::mdspan<E, X, L, A>& span,
+                   const std::array<size_t, X::rank()>& tile_sizes,
+                   F&& f) {
+  for_each_tile<L>(span.extents(), tile_sizes, std::forward<F>(f));
+}
+
+// -------------------------------------------------------------------------------------------------
+// Like `for_each_tile`, but the tiles along the slowest varying dimension are split in contiguous
+// blocks over `n_threads` threads. `f` must not throw.
+template <typename LayoutPolicy = std::layout_right, detail::StdExtents Extents, typename F>
+void parallel_for_tile(const Extents& extents,
+                       const std::array<size_t, Extents::rank()>& tile_sizes,
+                       F&& f,
+                       size_t n_threads = num_threads()) noexcept {
+  IGOR_ASSERT(std::ranges::all_of(tile_sizes, [](size_t s) { return s > 0UZ; }),
+              "Tile sizes must be positive.");
+  if constexpr (Extents::rank() == 0) {
+    f(IndexTile<Extents, LayoutPolicy>(extents, {}, {}));
+  } else {
+    constexpr size_t outer = detail::outer_dim<LayoutPolicy, Extents::rank()>;
+    const size_t n_outer   = detail::num_tiles(extents, tile_sizes, outer);
+    n_threads              = std::clamp(n_threads, 1UZ, std::max(n_outer, 1UZ));
+    parallel_for(
+        0UZ,
+        n_threads,
+        [&](size_t thread_id) {
+          const auto [begin, end] = detail::static_chunk(0UZ, n_outer, thread_id, n_threads);
+          detail::for_each_tile_in<LayoutPolicy>(extents, tile_sizes, begin, end, f);
+        },
+        n_threads);
+  }
+}
+
+template <typename E, typename X, typename L, typename A, typename F>
+void parallel_for_tile(const std::mdspan<E, X, L, A>& span,
+                       const std::array<size_t, X::rank()>& tile_sizes,
+                       F&& f,
+                       size_t n_threads = num_threads()) noexcept {
+  parallel_for_tile<L>(span.extents(), tile_sizes, std::forward<F>(f), n_threads);
+}
+
+}  // namespace Igor
+
+#endif  // IGOR_FOR_EACH_INDEX_HPP_
@@ -0,0 +1,296 @@
+#ifndef IGOR_HALO_HPP_
+#define IGOR_HALO_HPP_
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <mdspan>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include <Igor/Allocator.hpp>
+#include <Igor/Logging.hpp>
+#include <Igor/MdAccessor.hpp>
+#include <Igor/MdArray.hpp>
+
+namespace Igor {
+
+// =================================================================================================
+// Arrays with ghost layers for stencil codes. A HaloMdArray stores the interior cells surrounded by
+// `ghost_layers()` layers of ghost cells in every direction and hands out zero-copy strided views
+// of the interior, the ghost regions and the boundary regions (the interior cells a neighbour needs
+// to fill its ghost cells). `pack` and `unpack` move such a region to and from a contiguous buffer,
+// e.g. for MPI.
+// =================================================================================================
+
+// Position of a halo region along one dimension
+enum class HaloSide : std::uint8_t { LOW, CENTER, HIGH };
+
+namespace detail {
+
+// Strided view of the box [begin, begin + extents) of `span`
+template <typename E, typename X, typename L, typename A>
+[[nodiscard]] constexpr auto sub_box(const std::mdspan<E, X, L, A>& span,
+                                     const std::array<size_t, X::rank()>& begin,
+                                     const std::array<size_t, X::rank()>& extents) noexcept
+    -> std::mdspan<E, std::dextents<size_t, X::rank()>, std::layout_stride> {
+  static_assert(L::template mapping<X>::is_always_strided(), "Layout must be strided.");
+  static_assert(has_plain_accessor<std::mdspan<E, X, L, A>>, "Accessor must be a plain accessor.");
+  constexpr size_t rank = X::rank();
+
+  std::array<size_t, rank> strides{};
+  for (size_t r = 0; r < rank; ++r) {
+    IGOR_ASSERT(begin[r] + extents[r] <= static_cast<size_t>(span.extent(r)),
+                "Box exceeds the extent {} of dimension {}.",
+                span.extent(r),
+                r);
+    strides[r] = static_cast<size_t>(span.stride(r));
+  }
+  const auto offset = static_cast<size_t>(std::apply(span.mapping(), begin));
+  const std::layout_stride::mapping mapping(std::dextents<size_t, rank>(extents), strides);
+  return {span.data_handle() + offset, mapping};  // NOLINT
+}
+
+// Loop over a strided view in memory order and call `f(ptr, n, stride)` for every innermost run of
+// `n` elements; dimensions that are contiguous with respect to each other are merged into one run
+template <typename T, typename X, typename F>
+void for_each_strided_run(T* ptr,
+                          const X& view_extents,
+                          const std::array<size_t, X::rank()>& view_strides,
+                          F&& f) {
+  constexpr size_t RANK = X::rank();
+  // Sort the dimensions by decreasing stride
+  std::array<size_t, RANK> extents{};
+  std::array<size_t, RANK> strides{};
+  std::array<size_t, RANK> order{};
+  for (size_t r = 0; r < RANK; ++r) {
+    order[r] = r;
+  }
+  std::ranges::sort(order, [&](size_t a, size_t b) { return view_strides[a] > view_strides[b]; });
+  for (size_t r = 0; r < RANK; ++r) {
+    extents[r] = view_extents.extent(order[r]);
+    strides[r] = view_strides[order[r]];
+  }
+  size_t inner = RANK - 1UZ;
+  for (size_t r = RANK - 1UZ; r-- > 0UZ;) {
+    if (extents[r] == 1UZ) { continue; }
+    if (strides[r] == extents[inner] * strides[inner]) {
+      extents[inner] *= extents[r];
+      extents[r] = 1UZ;
+    } else {
+      inner = r;
+    }
+  }
+
+  const auto walk = [&]<size_t DEPTH>(auto& self, T* p) -> void {
+    if constexpr (DEPTH + 1UZ == RANK) {
+      f(p, extents[DEPTH], strides[DEPTH]);
+    } else {
+      for (size_t i = 0; i < extents[DEPTH]; ++i) {
+        self.template operator()<DEPTH + 1UZ>(self, p + i * strides[DEPTH]);  // NOLINT
+      }
+    }
+  };
+  walk.template operator()<0UZ>(walk, ptr);
+}
+
+}  // namespace detail
+
+// -------------------------------------------------------------------------------------------------
+// Copy the elements of a strided view (e.g. a face of a HaloMdArray) into the contiguous `buffer`
+// in the memory order of the view, returns the number of elements written. Contiguous runs are
+// copied with memcpy. `unpack` on a view with the same extents and strides restores the elements.
+template <typename E, typename X, typename A>
+auto pack(const std::mdspan<E, X, std::layout_stride, A>& view,
+          std::remove_const_t<E>* buffer) noexcept -> size_t {
+  using T = std::remove_const_t<E>;
+  static_assert(std::is_trivially_copyable_v<T>, "Element type must be trivially copyable.");
+  static_assert(detail::has_plain_accessor<std::mdspan<E, X, std::layout_stride, A>>,
+                "Accessor must be a plain accessor.");
+  constexpr size_t RANK = X::rank();
+  std::array<size_t, RANK> strides{};
+  for (size_t r = 0; r < RANK; ++r) {
+    strides[r] = view.stride(r);
+  }
+
+  T* out = buffer;
+  if (view.size() == 0UZ) { return 0UZ; }
+  detail::for_each_strided_run(view.data_handle(),
+                               view.extents(),
+                               strides,
+                               [&](const T* p, size_t n, size_t stride) {
+                                 // NOLINTBEGIN(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+                                 if (stride == 1UZ) {
+                                   std::memcpy(out, p, n * sizeof(T));
+                                 } else {
+                                   for (size_t i = 0; i < n; ++i) {
+                                     out[i] = p[i * stride];
+                                   }
+                                 }
+                                 out += n;
+                                 // NOLINTEND(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+                               });
+  return static_cast<size_t>(out - buffer);
+}
+
+// Copy the elements of the contiguous `buffer` written by `pack` into a strided view, returns the
+// number of elements read
+template <typename T, typename X, typename A>
+auto unpack(const T* buffer, const std::mdspan<T, X, std::layout_stride, A>& view) noexcept
+    -> size_t {
+  static_assert(std::is_trivially_copyable_v<T>, "Element type must be trivially copyable.");
+  static_assert(detail::has_plain_accessor<std::mdspan<T, X, std::layout_stride, A>>,
+                "Accessor must be a plain accessor.");
+  constexpr size_t RANK = X::rank();
+  std::array<size_t, RANK> strides{};
+  for (size_t r = 0; r < RANK; ++r) {
+    strides[r] = view.stride(r);
+  }
+
+  const T* in = buffer;
+  if (view.size() == 0UZ) { return 0UZ; }
+  detail::for_each_strided_run(
+      view.data_handle(), view.extents(), strides, [&](T* p, size_t n, size_t stride) {
+        // NOLINTBEGIN(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        if (stride == 1UZ) {
+          std::memcpy(p, in, n * sizeof(T));
+        } else {
+          for (size_t i = 0; i < n; ++i) {
+            p[i * stride] = in[i];
+          }
+        }
+        in += n;
+        // NOLINTEND(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+      });
+  return static_cast<size_t>(in - buffer);
+}
+
+// -------------------------------------------------------------------------------------------------
+// MdArray whose extents include `ghost_layers` ghost cells on both sides of every dimension. The
+// array itself is indexed including the ghost cells, i.e. the interior starts at index
+// `ghost_layers()` in every dimension; `interior()` is indexed from zero.
+template <typename ElementType,
+          size_t RANK,
+          typename LayoutPolicy = std::layout_right,
+          typename Allocator    = AlignedAllocator<ElementType>>
+class HaloMdArray : public MdArray<ElementType,
+                                   std::dextents<size_t, RANK>,
+                                   LayoutPolicy,
+                                   std::default_accessor<ElementType>,
+                                   Allocator> {
+  using Base = MdArray<ElementType,
+                       std::dextents<size_t, RANK>,
+                       LayoutPolicy,
+                       std::default_accessor<ElementType>,
+                       Allocator>;
+  static_assert(RANK > 0UZ, "HaloMdArray requires at least one dimension.");
+  static_assert(LayoutPolicy::template mapping<std::dextents<size_t, RANK>>::is_always_strided(),
+                "LayoutPolicy must be strided.");
+
+ public:
+  using view_type       = std::mdspan<ElementType, std::dextents<size_t, RANK>, std::layout_stride>;
+  using const_view_type =
+      std::mdspan<const ElementType, std::dextents<size_t, RANK>, std::layout_stride>;
+
+ private:
+  size_t m_ghost_layers = 0;
+
+  // Begin and extent of the region at `side` in dimension `r`, `boundary` selects the interior
+  // cells next to the ghost cells instead of the ghost cells
+  [[nodiscard]] constexpr auto region(size_t r, HaloSide side, bool boundary) const noexcept
+      -> std::pair<size_t, size_t> {
+    const size_t g = m_ghost_layers;
+    const size_t n = interior_extent(r);
+    switch (side) {
+      case HaloSide::LOW:    return {boundary ? g : 0UZ, g};
+      case HaloSide::CENTER: return {g, n};
+      case HaloSide::HIGH:   return {boundary ? n : n + g, g};
+    }
+    std::unreachable();
+  }
+
+  [[nodiscard]] constexpr auto region_view(const std::array<HaloSide, RANK>& sides,
+                                           bool boundary) const noexcept -> view_type {
+    std::array<size_t, RANK> begin{};
+    std::array<size_t, RANK> extents{};
+    for (size_t r = 0; r < RANK; ++r) {
+      std::tie(begin[r], extents[r]) = region(r, sides[r], boundary);
+    }
+    using Mdspan = std::mdspan<ElementType, std::dextents<size_t, RANK>, LayoutPolicy>;
+    return detail::sub_box(static_cast<const Mdspan&>(*this), begin, extents);
+  }
+
+  [[nodiscard]] static constexpr auto face_sides(size_t dim, HaloSide side) noexcept
+      -> std::array<HaloSide, RANK> {
+    std::array<HaloSide, RANK> sides{};
+    sides.fill(HaloSide::CENTER);
+    sides[dim] = side;
+    return sides;
+  }
+
+ public:
+  template <typename... Sizes>
+  requires(sizeof...(Sizes) == RANK && (std::is_convertible_v<Sizes, size_t> && ...))
+  HaloMdArray(size_t ghost_layers, Sizes... n)
+      : Base((static_cast<size_t>(n) + 2UZ * ghost_layers)...),
+        m_ghost_layers(ghost_layers) {}
+
+  template <detail::MdArrayInit Init, typename... Sizes>
+  requires(sizeof...(Sizes) == RANK && (std::is_convertible_v<Sizes, size_t> && ...))
+  HaloMdArray(size_t ghost_layers, Init init, Sizes... n)
+      : Base(init, (static_cast<size_t>(n) + 2UZ * ghost_layers)...),
+        m_ghost_layers(ghost_layers) {}
+
+  [[nodiscard]] constexpr auto ghost_layers() const noexcept -> size_t { return m_ghost_layers; }
+  [[nodiscard]] constexpr auto interior_extent(size_t r) const noexcept -> size_t {
+    return static_cast<size_t>(this->extent(r)) - 2UZ * m_ghost_layers;
+  }
+
+  // The interior cells without the ghost layers
+  [[nodiscard]] auto interior() noexcept -> view_type {
+    return region_view(face_sides(0, HaloSide::CENTER), false);
+  }
+  [[nodiscard]] auto interior() const noexcept -> const_view_type {
+    return region_view(face_sides(0, HaloSide::CENTER), false);
+  }
+
+  // Ghost cells in the direction `sides`, e.g. {LOW, CENTER, CENTER} is the ghost face at the low
+  // end of the first dimension, {LOW, HIGH, CENTER} an edge and {LOW, LOW, LOW} a corner
+  [[nodiscard]] auto ghost(const std::array<HaloSide, RANK>& sides) noexcept -> view_type {
+    return region_view(sides, false);
+  }
+  [[nodiscard]] auto ghost(const std::array<HaloSide, RANK>& sides) const noexcept
+      -> const_view_type {
+    return region_view(sides, false);
+  }
+
+  // Interior cells that fill the ghost cells of the neighbour in the direction `sides`
+  [[nodiscard]] auto boundary(const std::array<HaloSide, RANK>& sides) noexcept -> view_type {
+    return region_view(sides, true);
+  }
+  [[nodiscard]] auto boundary(const std::array<HaloSide, RANK>& sides) const noexcept
+      -> const_view_type {
+    return region_view(sides, true);
+  }
+
+  // Faces, i.e. regions that are only off-center in dimension `dim`
+  [[nodiscard]] auto ghost_face(size_t dim, HaloSide side) noexcept -> view_type {
+    return ghost(face_sides(dim, side));
+  }
+  [[nodiscard]] auto ghost_face(size_t dim, HaloSide side) const noexcept -> const_view_type {
+    return ghost(face_sides(dim, side));
+  }
+  [[nodiscard]] auto boundary_face(size_t dim, HaloSide side) noexcept -> view_type {
+    return boundary(face_sides(dim, side));
+  }
+  [[nodiscard]] auto boundary_face(size_t dim, HaloSide side) const noexcept -> const_view_type {
+    return boundary(face_sides(dim, side));
+  }
+};
+
+}  // namespace Igor
+
+#endif  // IGOR_HALO_HPP_
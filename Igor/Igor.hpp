@@ -22,10 +22,13 @@
 #ifndef IGOR_HPP_
 #define IGOR_HPP_
 
+#include "./Allocator.hpp"
+#include "./BulkMemory.hpp"
 #include "./Logging.hpp"
 #include "./Macros.hpp"
 #include "./Math.hpp"
 #include "./MemoryToString.hpp"
+#include "./Parallel.hpp"
 #include "./ProgressBar.hpp"
 #include "./StaticVector.hpp"
 #include "./Timer.hpp"
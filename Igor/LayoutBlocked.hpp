@@ -0,0 +1,158 @@
+#ifndef IGOR_LAYOUT_BLOCKED_HPP_
+#define IGOR_LAYOUT_BLOCKED_HPP_
+
+#include <array>
+#include <cstddef>
+#include <mdspan>
+#include <type_traits>
+#include <utility>
+
+#include <Igor/ForEachIndex.hpp>
+#include <Igor/Parallel.hpp>
+
+namespace Igor {
+
+// -------------------------------------------------------------------------------------------------
+// Layout that stores bricks of BLOCK[0] x BLOCK[1] x ... elements contiguously, e.g.
+// `layout_blocked<4, 4, 4>` for 3D stencils s.t. neighbours in all directions are close in memory.
+// Bricks and the elements within a brick are ordered like layout_right. The extents are padded to
+// whole bricks, i.e. the required span size is larger than the number of elements unless all
+// extents are multiples of the block sizes.
+template <size_t... BLOCK>
+struct layout_blocked {
+  static_assert(sizeof...(BLOCK) > 0UZ, "layout_blocked requires at least one dimension.");
+  static_assert(((BLOCK > 0UZ) && ...), "Block sizes must be positive.");
+
+  static constexpr std::array<size_t, sizeof...(BLOCK)> block_sizes{BLOCK...};
+  static constexpr size_t block_volume = (BLOCK * ...);
+
+  template <typename Extents>
+  class mapping {
+    static_assert(Extents::rank() == sizeof...(BLOCK),
+                  "Number of block sizes must match the rank of the extents.");
+
+   public:
+    using extents_type = Extents;
+    using index_type   = typename Extents::index_type;
+    using size_type    = typename Extents::size_type;
+    using rank_type    = typename Extents::rank_type;
+    using layout_type  = layout_blocked;
+
+   private:
+    static constexpr size_t RANK = Extents::rank();
+
+    extents_type m_extents{};
+    std::array<index_type, RANK> m_num_bricks{};
+
+    [[nodiscard]] static constexpr auto num_bricks(const extents_type& extents) noexcept
+        -> std::array<index_type, RANK> {
+      std::array<index_type, RANK> res{};
+      for (size_t r = 0; r < RANK; ++r) {
+        const auto block = static_cast<index_type>(block_sizes[r]);
+        res[r]           = (extents.extent(r) + block - 1) / block;
+      }
+      return res;
+    }
+
+   public:
+    constexpr mapping() noexcept
+        : mapping(extents_type{}) {}
+    constexpr mapping(const extents_type& extents) noexcept
+        : m_extents(extents),
+          m_num_bricks(num_bricks(extents)) {}
+
+    template <typename OtherExtents>
+    requires std::is_constructible_v<extents_type, OtherExtents>
+    constexpr explicit(!std::is_convertible_v<OtherExtents, extents_type>)
+        mapping(const mapping<OtherExtents>& other) noexcept
+        : mapping(extents_type(other.extents())) {}
+
+    [[nodiscard]] constexpr auto extents() const noexcept -> const extents_type& {
+      return m_extents;
+    }
+
+    [[nodiscard]] constexpr auto required_span_size() const noexcept -> index_type {
+      index_type bricks = 1;
+      for (size_t r = 0; r < RANK; ++r) {
+        if (m_extents.extent(r) == 0) { return 0; }
+        bricks *= m_num_bricks[r];
+      }
+      return bricks * static_cast<index_type>(block_volume);
+    }
+
+    template <typename... Indices>
+    requires(sizeof...(Indices) == RANK && (std::is_convertible_v<Indices, index_type> && ...))
+    [[nodiscard]] constexpr auto operator()(Indices... indices) const noexcept -> index_type {
+      const std::array<index_type, RANK> idx{static_cast<index_type>(indices)...};
+      index_type brick = 0;
+      index_type inner = 0;
+      for (size_t r = 0; r < RANK; ++r) {
+        const auto block = static_cast<index_type>(block_sizes[r]);
+        brick            = brick * m_num_bricks[r] + idx[r] / block;
+        inner            = inner * block + idx[r] % block;
+      }
+      return brick * static_cast<index_type>(block_volume) + inner;
+    }
+
+    [[nodiscard]] static constexpr auto is_always_unique() noexcept -> bool { return true; }
+    [[nodiscard]] static constexpr auto is_always_exhaustive() noexcept -> bool {
+      for (size_t r = 0; r < RANK; ++r) {
+        if (block_sizes[r] != 1UZ && (Extents::static_extent(r) == std::dynamic_extent ||
+                                      Extents::static_extent(r) % block_sizes[r] != 0UZ)) {
+          return false;
+        }
+      }
+      return true;
+    }
+    [[nodiscard]] static constexpr auto is_always_strided() noexcept -> bool { return false; }
+
+    [[nodiscard]] static constexpr auto is_unique() noexcept -> bool { return true; }
+    [[nodiscard]] constexpr auto is_exhaustive() const noexcept -> bool {
+      for (size_t r = 0; r < RANK; ++r) {
+        if (m_extents.extent(r) % static_cast<index_type>(block_sizes[r]) != 0) { return false; }
+      }
+      return true;
+    }
+    [[nodiscard]] static constexpr auto is_strided() noexcept -> bool { return false; }
+
+    template <typename OtherExtents>
+    [[nodiscard]] friend constexpr auto operator==(const mapping& lhs,
+                                                   const mapping<OtherExtents>& rhs) noexcept
+        -> bool {
+      return lhs.extents() == rhs.extents();
+    }
+  };
+};
+
+namespace detail {
+
+template <typename LayoutPolicy>
+struct is_layout_blocked : std::false_type {};
+template <size_t... BLOCK>
+struct is_layout_blocked<layout_blocked<BLOCK...>> : std::true_type {};
+
+}  // namespace detail
+
+// -------------------------------------------------------------------------------------------------
+// Call `f(tile)` with an `IndexTile` for every brick of a layout_blocked mdspan, in memory order.
+// A full brick (`tile.size() == layout_blocked<...>::block_volume`) occupies the contiguous range
+// starting at `span.mapping()(tile.begin(0), ...)`.
+template <typename E, typename X, typename L, typename A, typename F>
+requires detail::is_layout_blocked<L>::value
+void for_each_brick(const std::mdspan<E, X, L, A>& span, F&& f) {
+  for_each_tile<L>(span.extents(), L::block_sizes, std::forward<F>(f));
+}
+
+// Like `for_each_brick`, but bricks along the first dimension are split over `n_threads` threads.
+// `f` must not throw.
+template <typename E, typename X, typename L, typename A, typename F>
+requires detail::is_layout_blocked<L>::value
+void parallel_for_brick(const std::mdspan<E, X, L, A>& span,
+                        F&& f,
+                        size_t n_threads = num_threads()) noexcept {
+  parallel_for_tile<L>(span.extents(), L::block_sizes, std::forward<F>(f), n_threads);
+}
+
+}  // namespace Igor
+
+#endif  // IGOR_LAYOUT_BLOCKED_HPP_
@@ -0,0 +1,128 @@
+#ifndef IGOR_LAYOUT_PADDED_HPP_
+#define IGOR_LAYOUT_PADDED_HPP_
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <mdspan>
+#include <type_traits>
+
+namespace Igor {
+
+// -------------------------------------------------------------------------------------------------
+// Layout like layout_right whose rows are padded: the last extent is rounded up to a multiple of
+// ALIGNMENT elements, e.g. s.t. every row of an aligned buffer starts aligned for vector loads.
+// With AVOID_POWER_OF_TWO, all padded extents except the first that are (after rounding) a power of
+// two of at least 64 elements are extended by ALIGNMENT elements. Then rows and planes of 512^3 or
+// 1024^2 grids are not mapped to the same cache sets.
+template <size_t ALIGNMENT = 8UZ, bool AVOID_POWER_OF_TWO = true>
+struct layout_padded {
+  static_assert(ALIGNMENT > 0UZ, "ALIGNMENT must be positive.");
+
+  template <typename Extents>
+  class mapping {
+   public:
+    using extents_type = Extents;
+    using index_type   = typename Extents::index_type;
+    using size_type    = typename Extents::size_type;
+    using rank_type    = typename Extents::rank_type;
+    using layout_type  = layout_padded;
+
+   private:
+    static constexpr size_t RANK = Extents::rank();
+    // Power of two extents below this size are not padded, their aliasing does not matter
+    static constexpr index_type MIN_ALIASING_EXTENT = 64;
+
+    extents_type m_extents{};
+    std::array<index_type, RANK> m_strides{};
+
+    [[nodiscard]] static constexpr auto padded_extent(index_type n, bool is_last) noexcept
+        -> index_type {
+      const auto alignment = static_cast<index_type>(ALIGNMENT);
+      index_type padded    = is_last ? (n + alignment - 1) / alignment * alignment : n;
+      if constexpr (AVOID_POWER_OF_TWO) {
+        if (padded >= MIN_ALIASING_EXTENT &&
+            std::has_single_bit(static_cast<std::make_unsigned_t<index_type>>(padded))) {
+          padded += alignment;
+        }
+      }
+      return padded;
+    }
+
+    [[nodiscard]] static constexpr auto strides(const extents_type& extents) noexcept
+        -> std::array<index_type, RANK> {
+      std::array<index_type, RANK> res{};
+      index_type stride = 1;
+      for (size_t r = RANK; r-- > 0;) {
+        res[r] = stride;
+        if (r > 0) { stride *= padded_extent(extents.extent(r), r + 1 == RANK); }
+      }
+      return res;
+    }
+
+   public:
+    constexpr mapping() noexcept
+        : mapping(extents_type{}) {}
+    constexpr mapping(const extents_type& extents) noexcept
+        : m_extents(extents),
+          m_strides(strides(extents)) {}
+
+    template <typename OtherExtents>
+    requires std::is_constructible_v<extents_type, OtherExtents>
+    constexpr explicit(!std::is_convertible_v<OtherExtents, extents_type>)
+        mapping(const mapping<OtherExtents>& other) noexcept
+        : mapping(extents_type(other.extents())) {}
+
+    [[nodiscard]] constexpr auto extents() const noexcept -> const extents_type& {
+      return m_extents;
+    }
+
+    [[nodiscard]] constexpr auto required_span_size() const noexcept -> index_type {
+      index_type size = 1;
+      for (size_t r = 0; r < RANK; ++r) {
+        if (m_extents.extent(r) == 0) { return 0; }
+        size += (m_extents.extent(r) - 1) * m_strides[r];
+      }
+      return size;
+    }
+
+    template <typename... Indices>
+    requires(sizeof...(Indices) == RANK && (std::is_convertible_v<Indices, index_type> && ...))
+    [[nodiscard]] constexpr auto operator()(Indices... indices) const noexcept -> index_type {
+      return [&]<size_t... DIMS>(std::index_sequence<DIMS...>) {
+        return ((static_cast<index_type>(indices) * m_strides[DIMS]) + ... + 0);
+      }(std::make_index_sequence<RANK>{});
+    }
+
+    [[nodiscard]] constexpr auto stride(rank_type r) const noexcept -> index_type {
+      return m_strides[r];
+    }
+
+    [[nodiscard]] static constexpr auto is_always_unique() noexcept -> bool { return true; }
+    [[nodiscard]] static constexpr auto is_always_exhaustive() noexcept -> bool {
+      return RANK <= 1UZ && ALIGNMENT == 1UZ && !AVOID_POWER_OF_TWO;
+    }
+    [[nodiscard]] static constexpr auto is_always_strided() noexcept -> bool { return true; }
+
+    [[nodiscard]] static constexpr auto is_unique() noexcept -> bool { return true; }
+    [[nodiscard]] constexpr auto is_exhaustive() const noexcept -> bool {
+      size_t size = 1;
+      for (size_t r = 0; r < RANK; ++r) {
+        size *= static_cast<size_t>(m_extents.extent(r));
+      }
+      return size == static_cast<size_t>(required_span_size());
+    }
+    [[nodiscard]] static constexpr auto is_strided() noexcept -> bool { return true; }
+
+    template <typename OtherExtents>
+    [[nodiscard]] friend constexpr auto operator==(const mapping& lhs,
+                                                   const mapping<OtherExtents>& rhs) noexcept
+        -> bool {
+      return lhs.extents() == rhs.extents();
+    }
+  };
+};
+
+}  // namespace Igor
+
+#endif  // IGOR_LAYOUT_PADDED_HPP_
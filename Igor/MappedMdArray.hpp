@@ -0,0 +1,238 @@
+#ifndef IGOR_MAPPED_MD_ARRAY_HPP_
+#define IGOR_MAPPED_MD_ARRAY_HPP_
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <mdspan>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <Igor/Logging.hpp>
+#include <Igor/MdspanToNpy.hpp>
+
+namespace Igor {
+
+// How a file is mapped into memory
+enum class MapMode : std::uint8_t {
+  READ_ONLY,      // Writes to the mapping are not allowed
+  COPY_ON_WRITE,  // Written pages are copied privately, the file is never modified
+};
+
+// Access pattern hint for the kernel, see `madvise(2)`
+enum class AccessAdvice : std::uint8_t {
+  NORMAL,      // `MADV_NORMAL`
+  SEQUENTIAL,  // `MADV_SEQUENTIAL`, aggressive read-ahead, pages can be dropped after access
+  RANDOM,      // `MADV_RANDOM`, no read-ahead
+  WILL_NEED,   // `MADV_WILLNEED`, start reading the pages now
+  DONT_NEED,   // `MADV_DONTNEED`, drop the pages, private modifications are lost
+};
+
+// -------------------------------------------------------------------------------------------------
+// RAII handle for a file mapped into memory with `mmap`.
+class MappedFile {
+  std::string m_filename{};
+  void* m_data  = nullptr;
+  size_t m_size = 0;
+
+  constexpr MappedFile(std::string filename, void* data, size_t size) noexcept
+      : m_filename(std::move(filename)),
+        m_data(data),
+        m_size(size) {}
+
+ public:
+  // -----------------------------------------------------------------------------------------------
+  // Map the whole file, fails for empty files.
+  [[nodiscard]] static auto open(std::string filename, MapMode mode = MapMode::READ_ONLY) noexcept
+      -> std::optional<MappedFile> {
+    const int fd = ::open(filename.c_str(), O_RDONLY);
+    if (fd == -1) {
+      Igor::Warn("Could not open file `{}`: {}", filename, std::strerror(errno));
+      return std::nullopt;
+    }
+    struct stat info{};
+    if (fstat(fd, &info) == -1 || info.st_size <= 0) {
+      Igor::Warn("Could not map file `{}`: file is empty or cannot be inspected.", filename);
+      close(fd);
+      return std::nullopt;
+    }
+
+    const auto size = static_cast<size_t>(info.st_size);
+    const int prot  = mode == MapMode::READ_ONLY ? PROT_READ : PROT_READ | PROT_WRITE;
+    void* data      = mmap(nullptr, size, prot, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED) {
+      Igor::Warn("Could not map file `{}`: {}", filename, std::strerror(errno));
+      return std::nullopt;
+    }
+    return MappedFile{std::move(filename), data, size};
+  }
+
+  MappedFile(const MappedFile& other) noexcept                    = delete;
+  auto operator=(const MappedFile& other) noexcept -> MappedFile& = delete;
+  MappedFile(MappedFile&& other) noexcept
+      : m_filename(std::move(other.m_filename)),
+        m_data(std::exchange(other.m_data, nullptr)),
+        m_size(std::exchange(other.m_size, 0UZ)) {}
+  auto operator=(MappedFile&& other) noexcept -> MappedFile& {
+    if (this != &other) {
+      release();
+      m_filename = std::move(other.m_filename);
+      m_data     = std::exchange(other.m_data, nullptr);
+      m_size     = std::exchange(other.m_size, 0UZ);
+    }
+    return *this;
+  }
+  ~MappedFile() noexcept { release(); }
+
+  void release() noexcept {
+    if (m_data != nullptr) {
+      munmap(m_data, m_size);
+      m_data = nullptr;
+      m_size = 0;
+    }
+  }
+
+  // -----------------------------------------------------------------------------------------------
+  // Advise the kernel how the bytes [offset, offset + length) will be accessed, the range is
+  // extended to whole pages.
+  auto advise(AccessAdvice advice, size_t offset = 0, size_t length = SIZE_MAX) const noexcept
+      -> bool {
+    if (m_data == nullptr || offset >= m_size) { return false; }
+    length = std::min(length, m_size - offset);
+
+    const auto page_size = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    const size_t begin   = offset / page_size * page_size;
+    int flag             = MADV_NORMAL;
+    switch (advice) {
+      case AccessAdvice::NORMAL:     flag = MADV_NORMAL; break;
+      case AccessAdvice::SEQUENTIAL: flag = MADV_SEQUENTIAL; break;
+      case AccessAdvice::RANDOM:     flag = MADV_RANDOM; break;
+      case AccessAdvice::WILL_NEED:  flag = MADV_WILLNEED; break;
+      case AccessAdvice::DONT_NEED:  flag = MADV_DONTNEED; break;
+    }
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    if (madvise(static_cast<char*>(m_data) + begin, offset + length - begin, flag) == -1) {
+      Igor::Warn("Could not advise mapping of `{}`: {}", m_filename, std::strerror(errno));
+      return false;
+    }
+    return true;
+  }
+
+  [[nodiscard]] constexpr auto data() noexcept -> void* { return m_data; }
+  [[nodiscard]] constexpr auto data() const noexcept -> const void* { return m_data; }
+  [[nodiscard]] constexpr auto size() const noexcept -> size_t { return m_size; }
+  [[nodiscard]] constexpr auto filename() const noexcept -> const std::string& {
+    return m_filename;
+  }
+};
+
+// -------------------------------------------------------------------------------------------------
+// mdspan over a memory-mapped file, the elements are read lazily by the kernel on first access and
+// never copied. A const ElementType maps the file read-only, otherwise it is mapped copy-on-write,
+// i.e. the elements can be modified but the modifications are never written back to the file.
+template <typename ElementType, typename Extents, typename LayoutPolicy = std::layout_right>
+class MappedMdArray : public std::mdspan<ElementType, Extents, LayoutPolicy> {
+  using Base = std::mdspan<ElementType, Extents, LayoutPolicy>;
+  static_assert(std::is_trivially_copyable_v<ElementType>,
+                "Element type must be trivially copyable.");
+
+  MappedFile m_file;
+
+  MappedMdArray(MappedFile file,
+                size_t offset,
+                const typename Base::mapping_type& mapping) noexcept
+      : Base(reinterpret_cast<ElementType*>(static_cast<char*>(file.data()) + offset),  // NOLINT
+             mapping),
+        m_file(std::move(file)) {}
+
+  [[nodiscard]] static constexpr auto map_mode() noexcept -> MapMode {
+    return std::is_const_v<ElementType> ? MapMode::READ_ONLY : MapMode::COPY_ON_WRITE;
+  }
+
+  [[nodiscard]] static auto
+  from_file(MappedFile file, size_t offset, const Extents& extents) noexcept
+      -> std::optional<MappedMdArray> {
+    const typename Base::mapping_type mapping(extents);
+    const auto bytes = static_cast<size_t>(mapping.required_span_size()) * sizeof(ElementType);
+    if (offset % alignof(ElementType) != 0UZ) {
+      Igor::Warn("Offset {} into `{}` is not aligned for the element type.",
+                 offset,
+                 file.filename());
+      return std::nullopt;
+    }
+    if (offset > file.size() || bytes > file.size() - offset) {
+      Igor::Warn("`{}` contains {} bytes after offset {}, but {} bytes are required.",
+                 file.filename(),
+                 file.size() - std::min(offset, file.size()),
+                 offset,
+                 bytes);
+      return std::nullopt;
+    }
+    return MappedMdArray{std::move(file), offset, mapping};
+  }
+
+ public:
+  // -----------------------------------------------------------------------------------------------
+  // Map the raw elements stored at `offset` bytes into `filename`.
+  [[nodiscard]] static auto open(std::string filename,
+                                 const Extents& extents,
+                                 size_t offset = 0) noexcept -> std::optional<MappedMdArray> {
+    auto file = MappedFile::open(std::move(filename), map_mode());
+    if (!file.has_value()) { return std::nullopt; }
+    return from_file(std::move(*file), offset, extents);
+  }
+
+  // -----------------------------------------------------------------------------------------------
+  // Map the payload of an npy file, e.g. written by `mdspan_to_npy`. The element type, memory order
+  // and static extents must match the header, dynamic extents are taken from the header.
+  [[nodiscard]] static auto open_npy(std::string filename) noexcept
+      -> std::optional<MappedMdArray> {
+    static_assert(std::is_same_v<LayoutPolicy, std::layout_right> ||
+                      std::is_same_v<LayoutPolicy, std::layout_left>,
+                  "npy files can only be mapped with layout_right or layout_left.");
+    auto file = MappedFile::open(std::move(filename), map_mode());
+    if (!file.has_value()) { return std::nullopt; }
+
+    const std::string_view bytes(static_cast<const char*>(file->data()), file->size());
+    const auto header = detail::parse_npy_header(bytes, file->filename());
+    if (!header.has_value() ||
+        !detail::npy_header_matches<ElementType, Extents, LayoutPolicy>(*header,
+                                                                        file->filename())) {
+      return std::nullopt;
+    }
+
+    std::array<typename Extents::index_type, Extents::rank()> extents{};
+    for (size_t r = 0; r < Extents::rank(); ++r) {
+      extents[r] = static_cast<typename Extents::index_type>(header->shape[r]);
+    }
+    return from_file(std::move(*file), header->data_offset, Extents(extents));
+  }
+
+  // Advise the kernel how the elements will be accessed
+  auto advise(AccessAdvice advice) const noexcept -> bool {
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+    const auto* begin = reinterpret_cast<const char*>(this->data_handle());
+    const auto offset = static_cast<size_t>(begin - static_cast<const char*>(m_file.data()));
+    return m_file.advise(advice,
+                         offset,
+                         static_cast<size_t>(this->mapping().required_span_size()) *
+                             sizeof(ElementType));
+  }
+
+  [[nodiscard]] constexpr auto file() const noexcept -> const MappedFile& { return m_file; }
+};
+
+}  // namespace Igor
+
+#endif  // IGOR_MAPPED_MD_ARRAY_HPP_
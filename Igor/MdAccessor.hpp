@@ -0,0 +1,76 @@
+#ifndef IGOR_MD_ACCESSOR_HPP_
+#define IGOR_MD_ACCESSOR_HPP_
+
+#include <bit>
+#include <cstddef>
+#include <memory>
+#include <mdspan>
+#include <type_traits>
+
+namespace Igor {
+
+// -------------------------------------------------------------------------------------------------
+// Accessor that promises the compiler that the data handle is aligned to BYTE_ALIGNMENT bytes, e.g.
+// to allow aligned vector loads. Offsetting the data handle loses the alignment guarantee.
+template <typename ElementType, size_t BYTE_ALIGNMENT>
+struct aligned_accessor {
+  static_assert(std::has_single_bit(BYTE_ALIGNMENT), "BYTE_ALIGNMENT must be a power of two.");
+  static_assert(BYTE_ALIGNMENT >= alignof(ElementType),
+                "BYTE_ALIGNMENT must be at least the alignment of ElementType.");
+
+  using offset_policy    = std::default_accessor<ElementType>;
+  using element_type     = ElementType;
+  using reference        = ElementType&;
+  using data_handle_type = ElementType*;
+
+  static constexpr size_t byte_alignment = BYTE_ALIGNMENT;
+
+  constexpr aligned_accessor() noexcept = default;
+
+  template <typename OtherElementType, size_t OTHER_BYTE_ALIGNMENT>
+  requires(std::is_convertible_v<OtherElementType (*)[], ElementType (*)[]> &&  // NOLINT
+           OTHER_BYTE_ALIGNMENT >= BYTE_ALIGNMENT)
+  constexpr aligned_accessor(
+      aligned_accessor<OtherElementType, OTHER_BYTE_ALIGNMENT> /*other*/) noexcept {}
+
+  template <typename OtherElementType>
+  requires(std::is_convertible_v<OtherElementType (*)[], ElementType (*)[]>)  // NOLINT
+  constexpr explicit aligned_accessor(std::default_accessor<OtherElementType> /*other*/) noexcept {}
+
+  constexpr operator std::default_accessor<ElementType>() const noexcept { return {}; }
+
+  [[nodiscard]] constexpr auto access(data_handle_type p, size_t i) const noexcept -> reference {
+    return std::assume_aligned<BYTE_ALIGNMENT>(p)[i];  // NOLINT
+  }
+
+  [[nodiscard]] constexpr auto offset(data_handle_type p, size_t i) const noexcept ->
+      typename offset_policy::data_handle_type {
+    return p + i;  // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+  }
+};
+
+namespace detail {
+
+// Alignment of the data handle an accessor relies on
+template <typename AccessorPolicy>
+inline constexpr size_t accessor_alignment = alignof(typename AccessorPolicy::element_type);
+template <typename ElementType, size_t BYTE_ALIGNMENT>
+inline constexpr size_t accessor_alignment<aligned_accessor<ElementType, BYTE_ALIGNMENT>> =
+    BYTE_ALIGNMENT;
+
+// Type of the objects the data handle of an accessor points to, differs from the element type for
+// accessors that convert on access like `reduced_precision_accessor`
+template <typename AccessorPolicy>
+using accessor_storage_t = std::remove_pointer_t<typename AccessorPolicy::data_handle_type>;
+
+// The accessor of `Mdspan` reads plain memory, i.e. `data_handle()[i]` is the element at offset i
+template <typename Mdspan>
+inline constexpr bool has_plain_accessor =
+    std::is_pointer_v<typename Mdspan::data_handle_type> &&
+    std::is_same_v<typename Mdspan::reference, typename Mdspan::element_type&>;
+
+}  // namespace detail
+
+}  // namespace Igor
+
+#endif  // IGOR_MD_ACCESSOR_HPP_
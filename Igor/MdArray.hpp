@@ -1,43 +1,738 @@
 #ifndef IGOR_MD_ARRAY_HPP_
 #define IGOR_MD_ARRAY_HPP_
 
+#include <array>
+#include <concepts>
+#include <cstdint>
 #include <mdspan>
 #include <memory>
+#include <memory_resource>
+#include <utility>
 
+#include <Igor/Allocator.hpp>
+#include <Igor/BulkMemory.hpp>
+#include <Igor/ForEachIndex.hpp>
 #include <Igor/Logging.hpp>
+#include <Igor/MdAccessor.hpp>
+#include <Igor/MdIterator.hpp>
+#include <Igor/Parallel.hpp>
+#include <Igor/ReducedPrecision.hpp>
+#include <Igor/StaticVector.hpp>
+#include <Igor/Transpose.hpp>
 
 namespace Igor {
 
+template <typename Node>
+class MdExpr;
+
+// -------------------------------------------------------------------------------------------------
+// Initialization policies for the elements of an MdArray, the default is default-initialization
+// like `new ElementType[n]`.
+struct uninitialized_t {
+  explicit uninitialized_t() = default;
+};
+// Leave the elements uninitialized, e.g. because they are overwritten anyway; requires trivial
+// element types.
+inline constexpr uninitialized_t uninitialized{};
+
+struct zero_init_t {
+  explicit zero_init_t() = default;
+};
+// Value-initialize the elements, uses lazily zeroed memory (calloc or fresh mappings) if the
+// allocator supports it s.t. untouched pages do not consume memory.
+inline constexpr zero_init_t zero_init{};
+
+struct first_touch_t {
+  explicit first_touch_t() = default;
+};
+// Value-initialize the elements in parallel with the static decomposition of `Igor::parallel_for`
+// over the slowest varying extent, the same decomposition a `schedule(static)` kernel uses for its
+// outer loop. Pages end up on the NUMA node of the thread that works on them.
+inline constexpr first_touch_t first_touch{};
+
+namespace detail {
+
+struct default_init_t {
+  explicit default_init_t() = default;
+};
+
+template <typename Init>
+concept MdArrayInit = std::is_same_v<Init, uninitialized_t> || std::is_same_v<Init, zero_init_t> ||
+                      std::is_same_v<Init, first_touch_t>;
+
+template <typename Allocator>
+concept ZeroedAllocator = requires(Allocator alloc, size_t n) {
+  { alloc.allocate_zeroed(n) } -> std::same_as<typename std::allocator_traits<Allocator>::pointer>;
+};
+
+struct adopt_buffer_t {
+  explicit adopt_buffer_t() = default;
+};
+inline constexpr adopt_buffer_t adopt_buffer{};
+
+// Reshaping reinterprets the elements in memory order, which is well defined for C order
+// (layout_right) and Fortran order (layout_left)
+template <typename LayoutPolicy>
+concept ReshapeableLayout = std::is_same_v<LayoutPolicy, std::layout_right> ||
+                            std::is_same_v<LayoutPolicy, std::layout_left>;
+
+// Both extents contain the same number of elements, always true unless all extents are static
+template <typename FromExtents, typename ToExtents>
+[[nodiscard]] consteval auto static_sizes_match() noexcept -> bool {
+  if constexpr (FromExtents::rank_dynamic() > 0UZ || ToExtents::rank_dynamic() > 0UZ) {
+    return true;
+  } else {
+    size_t from = 1;
+    for (size_t r = 0; r < FromExtents::rank(); ++r) {
+      from *= FromExtents::static_extent(r);
+    }
+    size_t to = 1;
+    for (size_t r = 0; r < ToExtents::rank(); ++r) {
+      to *= ToExtents::static_extent(r);
+    }
+    return from == to;
+  }
+}
+
+// MdArrays with only static extents whose buffer has at most this many bytes store their elements
+// inline instead of allocating them, see the specialization of MdArray below
+inline constexpr size_t INLINE_STORAGE_BYTES = 512UZ;
+
+// Number of elements required by a layout mapping of static extents
+template <typename Extents, typename LayoutPolicy>
+inline constexpr size_t static_span_size = static_cast<size_t>(
+    typename LayoutPolicy::template mapping<Extents>(Extents{}).required_span_size());
+
+template <typename ElementType, typename Extents, typename LayoutPolicy, typename AccessorPolicy>
+concept InlineStorage = Extents::rank_dynamic() == 0 &&
+                        std::is_same_v<typename AccessorPolicy::data_handle_type, ElementType*> &&
+                        static_span_size<Extents, LayoutPolicy> > 0UZ &&
+                        static_span_size<Extents, LayoutPolicy> * sizeof(ElementType) <=
+                            INLINE_STORAGE_BYTES;
+
+// Storage of an inline MdArray, a base class s.t. it is constructed before the mdspan that uses it
+template <typename ElementType, typename Extents, typename LayoutPolicy, typename AccessorPolicy>
+struct InlineBuffer {
+  static constexpr size_t SIZE = static_span_size<Extents, LayoutPolicy>;
+  alignas(accessor_alignment<AccessorPolicy>) UninitializedArray<ElementType, SIZE> m_storage{};
+};
+
+// -------------------------------------------------------------------------------------------------
+// Members shared by the heap allocated and the inline MdArray (CRTP). `Derived` provides
+// `get_data()`, the number of objects in its buffer via `buffer_size()` and, for `clone`, an array
+// with the same extents and allocator whose elements are overwritten anyway via `allocate_like()`.
+template <typename Derived,
+          typename ElementType,
+          typename Extents,
+          typename LayoutPolicy,
+          typename AccessorPolicy>
+class MdArrayBase : public std::mdspan<ElementType, Extents, LayoutPolicy, AccessorPolicy> {
+  using View         = std::mdspan<ElementType, Extents, LayoutPolicy, AccessorPolicy>;
+  using storage_type = accessor_storage_t<AccessorPolicy>;
+
+  [[nodiscard]] constexpr auto derived() noexcept -> Derived& {
+    return static_cast<Derived&>(*this);
+  }
+  [[nodiscard]] constexpr auto derived() const noexcept -> const Derived& {
+    return static_cast<const Derived&>(*this);
+  }
+
+ public:
+  using View::View;
+
+  // -----------------------------------------------------------------------------------------------
+  // Iterators over all elements for standard algorithms and ranges: contiguous iterators in memory
+  // order for exhaustive layouts, otherwise `MdIterator`s in the loop order of the layout.
+  [[nodiscard]] constexpr auto begin() noexcept {
+    return flat_view(static_cast<const View&>(*this)).begin();
+  }
+  [[nodiscard]] constexpr auto end() noexcept {
+    return flat_view(static_cast<const View&>(*this)).end();
+  }
+  [[nodiscard]] constexpr auto begin() const noexcept {
+    return flat_view(as_const_mdspan(static_cast<const View&>(*this))).begin();
+  }
+  [[nodiscard]] constexpr auto end() const noexcept {
+    return flat_view(as_const_mdspan(static_cast<const View&>(*this))).end();
+  }
+
+  // Evaluate an elementwise expression into this array, see Igor/MdExpression.hpp
+  template <typename Node>
+  auto operator=(const MdExpr<Node>& expr) -> Derived& {
+    evaluate(derived(), expr);
+    return derived();
+  }
+
+  // -----------------------------------------------------------------------------------------------
+  // Deep copy with the same extents, layout and allocator.
+  [[nodiscard]] constexpr auto clone() const -> Derived
+  requires(std::is_copy_constructible_v<storage_type>)
+  {
+    auto res = derived().allocate_like();
+    if consteval {
+      std::copy_n(derived().get_data(), derived().buffer_size(), res.get_data());
+    } else {
+      parallel_copy_n(derived().get_data(), derived().buffer_size(), res.get_data());
+    }
+    return res;
+  }
+
+  // -----------------------------------------------------------------------------------------------
+  // Copy the elements of `src`, which must have the same extents. Sources with the same layout are
+  // copied as one block, layout_left <-> layout_right with a blocked transposition (see
+  // `convert_layout`), other layouts element-wise in the order of this layout. Large copies are
+  // split over threads and use non-temporal stores.
+  template <typename OtherElementType,
+            typename OtherExtents,
+            typename OtherLayoutPolicy,
+            typename OtherAccessorPolicy>
+  requires(OtherExtents::rank() == Extents::rank() &&
+           std::is_assignable_v<typename View::reference,
+                                typename OtherAccessorPolicy::reference>)
+  constexpr void copy_from(
+      const std::mdspan<OtherElementType, OtherExtents, OtherLayoutPolicy, OtherAccessorPolicy>&
+          src) {
+    static_assert(
+        [] {
+          for (size_t r = 0; r < Extents::rank(); ++r) {
+            if (Extents::static_extent(r) != std::dynamic_extent &&
+                OtherExtents::static_extent(r) != std::dynamic_extent &&
+                Extents::static_extent(r) != OtherExtents::static_extent(r)) {
+              return false;
+            }
+          }
+          return true;
+        }(),
+        "Static extents of source and destination do not match.");
+    IGOR_ASSERT(src.extents() == this->extents(),
+                "Extents of source and destination do not match.");
+
+    constexpr bool plain_src =
+        std::is_same_v<std::remove_const_t<OtherElementType>, ElementType> &&
+        std::is_same_v<typename OtherAccessorPolicy::data_handle_type, OtherElementType*> &&
+        std::is_same_v<typename OtherAccessorPolicy::reference, OtherElementType&>;
+    constexpr bool plain_dst =
+        std::is_same_v<typename AccessorPolicy::data_handle_type, ElementType*> &&
+        std::is_same_v<typename AccessorPolicy::reference, ElementType&>;
+    constexpr bool left_or_right =
+        (std::is_same_v<OtherLayoutPolicy, std::layout_right> ||
+         std::is_same_v<OtherLayoutPolicy, std::layout_left>) &&
+        (std::is_same_v<LayoutPolicy, std::layout_right> ||
+         std::is_same_v<LayoutPolicy, std::layout_left>);
+    // Conversion between float and float16 or bfloat16 with the same layout
+    constexpr bool converts =
+        std::is_same_v<OtherLayoutPolicy, LayoutPolicy> && left_or_right &&
+        ((plain_src && std::is_same_v<std::remove_const_t<OtherElementType>, float> &&
+          is_reduced_precision_accessor<AccessorPolicy>::value) ||
+         (plain_dst && std::is_same_v<ElementType, float> &&
+          is_reduced_precision_accessor<OtherAccessorPolicy>::value));
+    constexpr bool nothrow_assign =
+        std::is_nothrow_assignable_v<typename View::reference,
+                                     typename OtherAccessorPolicy::reference>;
+    if consteval {
+      for_each_index<LayoutPolicy>(this->extents(),
+                                   [&](auto... idx) { (*this)[idx...] = src[idx...]; });
+      return;
+    }
+    if constexpr (plain_src && plain_dst && left_or_right && nothrow_assign) {
+      // A plain copy for identical layouts, otherwise a blocked transposition
+      convert_layout(src, static_cast<const View&>(*this));
+    } else if constexpr (converts) {
+      const size_t n         = this->size();
+      const size_t n_threads = n * sizeof(float) < PARALLEL_THRESHOLD_BYTES ? 1UZ : num_threads();
+      parallel_for(
+          0UZ,
+          n_threads,
+          [&](size_t thread_id) {
+            const auto [begin, end] = static_chunk(0UZ, n, thread_id, n_threads);
+            // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+            convert_n(src.data_handle() + begin, end - begin, derived().get_data() + begin);
+          },
+          n_threads);
+    } else {
+      for_each_outer_slab<nothrow_assign>([&](const auto& idx) { (*this)[idx] = src[idx]; });
+    }
+  }
+
+  // -----------------------------------------------------------------------------------------------
+  // Assign `value` to all elements; large arrays are filled in parallel with non-temporal stores.
+  constexpr void fill(const ElementType& value) {
+    if consteval {
+      for_each_index<LayoutPolicy>(this->extents(), [&](auto... idx) { (*this)[idx...] = value; });
+      return;
+    }
+    if constexpr (std::is_same_v<typename AccessorPolicy::data_handle_type, ElementType*> &&
+                  std::is_same_v<typename AccessorPolicy::reference, ElementType&>) {
+      parallel_fill_n(derived().get_data(), derived().buffer_size(), value);
+    } else {
+      constexpr bool nothrow_assign =
+          std::is_nothrow_assignable_v<typename View::reference, const ElementType&>;
+      for_each_outer_slab<nothrow_assign>([&](const auto& idx) { (*this)[idx] = value; });
+    }
+  }
+
+ private:
+  // Call `f(idx)` for all indices in the loop order of the layout, slabs of the slowest varying
+  // extent are distributed over threads for large arrays if `f` cannot throw (NOTHROW), otherwise
+  // the loop runs on the calling thread s.t. exceptions propagate
+  template <bool NOTHROW, typename F>
+  void for_each_outer_slab(F&& f) {
+    constexpr bool left = std::is_same_v<LayoutPolicy, std::layout_left>;
+    if constexpr (Extents::rank() == 0) {
+      f(std::array<typename Extents::index_type, 0>{});
+    } else if constexpr (!NOTHROW) {
+      std::array<typename Extents::index_type, Extents::rank()> idx{};
+      constexpr size_t outer_dim = left ? Extents::rank() - 1UZ : 0UZ;
+      nested_for<left>(this->extents(), idx, 0UZ, static_cast<size_t>(this->extent(outer_dim)), f);
+    } else {
+      constexpr size_t outer_dim = left ? Extents::rank() - 1UZ : 0UZ;
+      const auto num_slabs       = static_cast<size_t>(this->extent(outer_dim));
+      const size_t n_threads =
+          this->size() * sizeof(ElementType) < PARALLEL_THRESHOLD_BYTES ? 1UZ : num_threads();
+      parallel_for(
+          0UZ,
+          std::min(n_threads, num_slabs),
+          [&](size_t thread_id) {
+            const auto [begin, end] =
+                static_chunk(0UZ, num_slabs, thread_id, std::min(n_threads, num_slabs));
+            std::array<typename Extents::index_type, Extents::rank()> idx{};
+            nested_for<left>(this->extents(), idx, begin, end, f);
+          },
+          n_threads);
+    }
+  }
+};
+
+}  // namespace detail
+
 template <typename ElementType,
           typename Extents,
           typename LayoutPolicy   = std::layout_right,
-          typename AccessorPolicy = std::default_accessor<ElementType>>
-class MdArray : public std::mdspan<ElementType, Extents, LayoutPolicy, AccessorPolicy> {
-  // NOLINTNEXTLINE(cppcoreguidelines-avoid-c-arrays,modernize-avoid-c-arrays)
-  std::unique_ptr<ElementType[]> m_buffer = nullptr;
+          typename AccessorPolicy = std::default_accessor<ElementType>,
+          typename Allocator      = AlignedAllocator<detail::accessor_storage_t<AccessorPolicy>>>
+class MdArray : public detail::MdArrayBase<MdArray<ElementType,
+                                                   Extents,
+                                                   LayoutPolicy,
+                                                   AccessorPolicy,
+                                                   Allocator>,
+                                           ElementType,
+                                           Extents,
+                                           LayoutPolicy,
+                                           AccessorPolicy> {
+  using Base = detail::MdArrayBase<MdArray, ElementType, Extents, LayoutPolicy, AccessorPolicy>;
+  friend Base;
+
+ public:
+  // Type of the objects in the buffer, the element type unless the accessor converts on access
+  using storage_type = detail::accessor_storage_t<AccessorPolicy>;
+
+ private:
+  static_assert(std::is_pointer_v<typename AccessorPolicy::data_handle_type>,
+                "Data handle of the accessor must be a pointer.");
+  static_assert(std::is_same_v<typename std::allocator_traits<Allocator>::value_type, storage_type>,
+                "Allocator must allocate objects of the storage type of the accessor.");
+
+  [[no_unique_address]] Allocator m_allocator{};
+  storage_type* m_buffer = nullptr;
+  size_t m_buffer_size   = 0;
+
+  // Zero-initialized memory from the allocator is only equivalent to value-initialization for
+  // trivial types
+  static constexpr bool allocates_zeroed =
+      detail::ZeroedAllocator<Allocator> &&
+      std::is_trivially_default_constructible_v<storage_type> &&
+      std::is_trivially_destructible_v<storage_type>;
+
+  template <typename Init>
+  [[nodiscard]] static constexpr auto
+  allocate(Init /*init*/, Allocator& allocator, size_t buffer_size) -> storage_type* {
+    if constexpr (std::is_same_v<Init, zero_init_t> && allocates_zeroed) {
+      return allocator.allocate_zeroed(buffer_size);
+    } else {
+      return std::allocator_traits<Allocator>::allocate(allocator, buffer_size);
+    }
+  }
+
+  template <typename, typename, typename, typename, typename>
+  friend class MdArray;
+
+  // Take ownership of a buffer allocated by `allocator`, see `reshape`
+  constexpr MdArray(detail::adopt_buffer_t /*tag*/,
+                    Allocator allocator,
+                    storage_type* buffer,
+                    size_t buffer_size,
+                    const Extents& extents) noexcept
+      : Base(buffer, extents),
+        m_allocator(std::move(allocator)),
+        m_buffer(buffer),
+        m_buffer_size(buffer_size) {}
+
+  template <typename Init, typename... Sizes>
+  requires(detail::MdArrayInit<Init> || std::is_same_v<Init, detail::default_init_t>)
+  constexpr MdArray(Init init, Allocator allocator, size_t buffer_size, Sizes... n)
+      : Base(allocate(init, allocator, buffer_size), n...),
+        m_allocator(std::move(allocator)),
+        m_buffer(this->data_handle()),
+        m_buffer_size(buffer_size) {
+    IGOR_ASSERT(reinterpret_cast<std::uintptr_t>(m_buffer) %  // NOLINT
+                        detail::accessor_alignment<AccessorPolicy> ==
+                    0,
+                "Buffer is not aligned to {} bytes as required by the accessor.",
+                detail::accessor_alignment<AccessorPolicy>);
+    try {
+      initialize(init);
+    } catch (...) {
+      std::allocator_traits<Allocator>::deallocate(m_allocator, m_buffer, m_buffer_size);
+      throw;
+    }
+  }
+
+  // Number of elements in the buffer, exceeds the number of indices for padded layouts like
+  // `layout_blocked`
+  template <typename... Sizes>
+  [[nodiscard]] static constexpr auto span_size(Sizes... n) noexcept -> size_t {
+    return static_cast<size_t>(
+        typename Base::mapping_type(Extents(n...)).required_span_size());
+  }
 
+  constexpr void initialize(detail::default_init_t /*init*/) {
+    std::uninitialized_default_construct_n(m_buffer, m_buffer_size);
+  }
+  constexpr void initialize(uninitialized_t /*init*/) noexcept {}
+  constexpr void initialize(zero_init_t /*init*/) {
+    if constexpr (!allocates_zeroed) {
+      std::uninitialized_value_construct_n(m_buffer, m_buffer_size);
+    }
+  }
+  void initialize(first_touch_t /*init*/) noexcept {
+    constexpr bool is_left     = std::is_same_v<LayoutPolicy, std::layout_left>;
+    constexpr size_t outer_dim = is_left && Extents::rank() > 0 ? Extents::rank() - 1UZ : 0UZ;
+    const size_t num_slabs =
+        Extents::rank() > 0 ? static_cast<size_t>(this->extent(outer_dim)) : 1UZ;
+    if (num_slabs == 0UZ) { return; }
+    // Slabs of the slowest varying extent are contiguous for exhaustive layouts, otherwise this
+    // degrades to a decomposition of the buffer in equally sized blocks.
+    const size_t slab_size = m_buffer_size / num_slabs;
+    parallel_for(0UZ, num_slabs, [&](size_t slab) {
+      const size_t end = slab + 1 == num_slabs ? m_buffer_size : (slab + 1) * slab_size;
+      // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+      std::uninitialized_value_construct(m_buffer + slab * slab_size, m_buffer + end);
+    });
+  }
+
+  constexpr void release() noexcept {
+    if (m_buffer != nullptr) {
+      std::destroy_n(m_buffer, m_buffer_size);
+      std::allocator_traits<Allocator>::deallocate(m_allocator, m_buffer, m_buffer_size);
+      m_buffer      = nullptr;
+      m_buffer_size = 0;
+    }
+  }
+
+  [[nodiscard]] constexpr auto buffer_size() const noexcept -> size_t { return m_buffer_size; }
+
+  // Array with the same extents and allocator for `clone`, trivial elements are left uninitialized
+  [[nodiscard]] auto allocate_like() const -> MdArray {
+    constexpr auto init = [] {
+      if constexpr (std::is_trivially_default_constructible_v<storage_type> &&
+                    std::is_trivially_destructible_v<storage_type>) {
+        return uninitialized;
+      } else {
+        return detail::default_init_t{};
+      }
+    }();
+    return [&]<size_t... DIMS>(std::index_sequence<DIMS...>) {
+      return MdArray(init,
+                     std::allocator_traits<Allocator>::select_on_container_copy_construction(
+                         m_allocator),
+                     m_buffer_size,
+                     this->extent(DIMS)...);
+    }(std::make_index_sequence<Extents::rank()>{});
+  }
+
+ public:
+  using allocator_type = Allocator;
+
+  template <typename... Sizes>
+  requires(std::is_convertible_v<std::remove_cvref_t<Sizes>, typename Extents::size_type> && ...)
+  constexpr MdArray(Sizes... n)
+      : MdArray(detail::default_init_t{}, Allocator{}, span_size(n...), n...) {}
+
+  template <detail::MdArrayInit Init, typename... Sizes>
+  requires(std::is_convertible_v<std::remove_cvref_t<Sizes>, typename Extents::size_type> && ...)
+  constexpr MdArray(Init init, Sizes... n)
+      : MdArray(std::allocator_arg, Allocator{}, init, n...) {}
+
+  // Allocate the buffer with a specific allocator instance, e.g. a
+  // `std::pmr::polymorphic_allocator` for an `ArenaResource` or a `PoolResource`
   template <typename... Sizes>
-  constexpr MdArray(ElementType* data, Sizes... n)
-      : std::mdspan<ElementType, Extents, LayoutPolicy, AccessorPolicy>(data, n...),
-        m_buffer(data) {}
+  requires(std::is_convertible_v<std::remove_cvref_t<Sizes>, typename Extents::size_type> && ...)
+  constexpr MdArray(std::allocator_arg_t /*tag*/, const Allocator& allocator, Sizes... n)
+      : MdArray(detail::default_init_t{}, allocator, span_size(n...), n...) {}
+
+  template <detail::MdArrayInit Init, typename... Sizes>
+  requires(std::is_convertible_v<std::remove_cvref_t<Sizes>, typename Extents::size_type> && ...)
+  constexpr MdArray(std::allocator_arg_t /*tag*/, const Allocator& allocator, Init init, Sizes... n)
+      : MdArray(init, allocator, span_size(n...), n...) {
+    static_assert(!std::is_same_v<Init, uninitialized_t> ||
+                      (std::is_trivially_default_constructible_v<storage_type> &&
+                       std::is_trivially_destructible_v<storage_type>),
+                  "Only trivial element types can be left uninitialized.");
+    static_assert(!std::is_same_v<Init, first_touch_t> ||
+                      std::is_nothrow_default_constructible_v<storage_type>,
+                  "First touch initialization requires a nothrow default constructible type.");
+  }
+
+  constexpr MdArray(const MdArray& other) noexcept        = delete;
+  constexpr auto operator=(const MdArray& other) noexcept = delete;
+  constexpr MdArray(MdArray&& other) noexcept
+      : Base(std::move(other)),
+        m_allocator(std::move(other.m_allocator)),
+        m_buffer(std::exchange(other.m_buffer, nullptr)),
+        m_buffer_size(std::exchange(other.m_buffer_size, 0UZ)) {}
+  // The allocator always travels with the buffer it allocated s.t. moves only transfer ownership,
+  // even for allocators that do not propagate on move assignment like `polymorphic_allocator`
+  constexpr auto operator=(MdArray&& other) noexcept -> MdArray& {
+    if (this != &other) {
+      release();
+      Base::operator=(std::move(other));
+      if constexpr (std::is_move_assignable_v<Allocator>) {
+        m_allocator = std::move(other.m_allocator);
+      } else {
+        std::destroy_at(&m_allocator);
+        std::construct_at(&m_allocator, std::move(other.m_allocator));
+      }
+      m_buffer      = std::exchange(other.m_buffer, nullptr);
+      m_buffer_size = std::exchange(other.m_buffer_size, 0UZ);
+    }
+    return *this;
+  }
+
+  constexpr ~MdArray() noexcept { release(); }
+
+  constexpr auto get_data() noexcept -> storage_type* { return m_buffer; }
+  constexpr auto get_data() const noexcept -> const storage_type* { return m_buffer; }
+
+  [[nodiscard]] constexpr auto get_allocator() const noexcept -> const Allocator& {
+    return m_allocator;
+  }
+
+  using Base::operator=;
+
+  // -----------------------------------------------------------------------------------------------
+  // Reinterpret the elements with extents `n...` in the memory order of the layout without copying:
+  // the returned array takes ownership of the buffer and this array is left empty. The number of
+  // elements must not change, which is checked at compile time if all extents are static. Without
+  // explicit NewExtents, all new extents are dynamic.
+  template <typename NewExtents, typename... Sizes>
+  requires(detail::ReshapeableLayout<LayoutPolicy> &&
+           (std::is_convertible_v<std::remove_cvref_t<Sizes>, typename NewExtents::size_type> &&
+            ...))
+  [[nodiscard]] constexpr auto reshape(Sizes... n) &&
+      -> MdArray<ElementType, NewExtents, LayoutPolicy, AccessorPolicy, Allocator> {
+    using Result = MdArray<ElementType, NewExtents, LayoutPolicy, AccessorPolicy, Allocator>;
+    static_assert(!detail::InlineStorage<ElementType, NewExtents, LayoutPolicy, AccessorPolicy>,
+                  "Small static extents are stored inline, reshaping to them requires a copy.");
+    static_assert(detail::static_sizes_match<Extents, NewExtents>(),
+                  "Reshaping must not change the number of elements.");
+    const NewExtents new_extents(n...);
+    IGOR_ASSERT(static_cast<size_t>(
+                    typename Result::mapping_type(new_extents).required_span_size()) ==
+                    m_buffer_size,
+                "Cannot reshape {} elements to extents with a different number of elements.",
+                m_buffer_size);
+    return Result(detail::adopt_buffer,
+                  std::move(m_allocator),
+                  std::exchange(m_buffer, nullptr),
+                  std::exchange(m_buffer_size, 0UZ),
+                  new_extents);
+  }
+
+  template <typename... Sizes>
+  requires(sizeof...(Sizes) > 0UZ &&
+           (std::is_convertible_v<std::remove_cvref_t<Sizes>, typename Extents::index_type> && ...))
+  [[nodiscard]] constexpr auto reshape(Sizes... n) && {
+    return std::move(*this)
+        .template reshape<std::dextents<typename Extents::index_type, sizeof...(Sizes)>>(n...);
+  }
+};
+
+// -------------------------------------------------------------------------------------------------
+// MdArray with only static extents and a small buffer (see `detail::InlineStorage`), e.g. a 3x3
+// tensor or stencil weights. The elements are stored inline, i.e. there is no heap allocation and
+// no pointer indirection, the array is copyable and can be used in constant expressions for
+// trivial element types. Elements of trivial types are always value-initialized, the allocator is
+// ignored.
+template <typename ElementType,
+          typename Extents,
+          typename LayoutPolicy,
+          typename AccessorPolicy,
+          typename Allocator>
+requires detail::InlineStorage<ElementType, Extents, LayoutPolicy, AccessorPolicy>
+class MdArray<ElementType, Extents, LayoutPolicy, AccessorPolicy, Allocator>
+    : private detail::InlineBuffer<ElementType, Extents, LayoutPolicy, AccessorPolicy>,
+      public detail::MdArrayBase<MdArray<ElementType,
+                                         Extents,
+                                         LayoutPolicy,
+                                         AccessorPolicy,
+                                         Allocator>,
+                                 ElementType,
+                                 Extents,
+                                 LayoutPolicy,
+                                 AccessorPolicy> {
+  using Base   = detail::MdArrayBase<MdArray, ElementType, Extents, LayoutPolicy, AccessorPolicy>;
+  using Buffer = detail::InlineBuffer<ElementType, Extents, LayoutPolicy, AccessorPolicy>;
+  using Buffer::m_storage;
+  friend Base;
+
+  static constexpr size_t BUFFER_SIZE = Buffer::SIZE;
+
+  // Elements of trivial types are value-initialized together with the storage, all other elements
+  // are constructed in place
+  static constexpr bool constructs_elements =
+      !detail::UninitializedArray<ElementType, BUFFER_SIZE>::constructor_and_destructor_are_cheap;
+
+  template <typename... Args>
+  constexpr void construct_elements(Args&&... args) {
+    for (size_t i = 0; i < BUFFER_SIZE; ++i) {
+      std::construct_at(m_storage.data() + i, std::forward<Args>(args)(i)...);  // NOLINT
+    }
+  }
+
+  [[nodiscard]] static constexpr auto buffer_size() noexcept -> size_t { return BUFFER_SIZE; }
+  [[nodiscard]] constexpr auto allocate_like() const -> MdArray { return MdArray{}; }
 
  public:
+  using allocator_type = Allocator;
+
   template <typename... Sizes>
   requires(std::is_convertible_v<std::remove_cvref_t<Sizes>, typename Extents::size_type> && ...)
   constexpr MdArray(Sizes... n)
-      : MdArray(new ElementType[static_cast<size_t>((n * ...))], n...) {}
+      : MdArray(detail::default_init_t{}, n...) {}
+
+  template <typename Init, typename... Sizes>
+  requires((detail::MdArrayInit<Init> || std::is_same_v<Init, detail::default_init_t>) &&
+           (std::is_convertible_v<std::remove_cvref_t<Sizes>, typename Extents::size_type> && ...))
+  constexpr MdArray(Init /*init*/, [[maybe_unused]] Sizes... n)
+      : Base(m_storage.data()) {
+    static_assert(!std::is_same_v<Init, uninitialized_t> ||
+                      (std::is_trivially_default_constructible_v<ElementType> &&
+                       std::is_trivially_destructible_v<ElementType>),
+                  "Only trivial element types can be left uninitialized.");
+    if constexpr (sizeof...(Sizes) > 0UZ) {
+      IGOR_ASSERT(Extents(n...) == Extents{}, "Extents do not match the static extents.");
+    }
+    if constexpr (constructs_elements) { construct_elements(); }
+  }
 
-  constexpr MdArray(const MdArray& other) noexcept               = delete;
-  constexpr MdArray(MdArray&& other) noexcept                    = default;
-  constexpr auto operator=(const MdArray& other) noexcept        = delete;
-  constexpr auto operator=(MdArray&& other) noexcept -> MdArray& = default;
+  constexpr MdArray(const MdArray& other)
+  requires(std::is_copy_constructible_v<ElementType>)
+      : Base(m_storage.data()) {
+    if constexpr (constructs_elements) {
+      construct_elements([&](size_t i) -> const ElementType& {
+        return other.m_storage.data()[i];  // NOLINT
+      });
+    } else {
+      std::copy_n(other.m_storage.data(), BUFFER_SIZE, m_storage.data());
+    }
+  }
+  constexpr auto operator=(const MdArray& other) -> MdArray&
+  requires(std::is_copy_assignable_v<ElementType>)
+  {
+    std::copy_n(other.m_storage.data(), BUFFER_SIZE, m_storage.data());
+    return *this;
+  }
+  constexpr MdArray(MdArray&& other) noexcept(std::is_nothrow_move_constructible_v<ElementType>)
+      : Base(m_storage.data()) {
+    if constexpr (constructs_elements) {
+      construct_elements([&](size_t i) -> ElementType&& {
+        return std::move(other.m_storage.data()[i]);  // NOLINT
+      });
+    } else {
+      std::copy_n(other.m_storage.data(), BUFFER_SIZE, m_storage.data());
+    }
+  }
+  constexpr auto operator=(MdArray&& other) noexcept(std::is_nothrow_move_assignable_v<ElementType>)
+      -> MdArray& {
+    std::move(other.m_storage.data(), other.m_storage.data() + BUFFER_SIZE,  // NOLINT
+              m_storage.data());
+    return *this;
+  }
 
-  constexpr ~MdArray() noexcept = default;
+  constexpr ~MdArray() noexcept
+  requires(std::is_trivially_destructible_v<ElementType>)
+  = default;
+  constexpr ~MdArray() noexcept { std::destroy_n(m_storage.data(), BUFFER_SIZE); }
 
-  constexpr auto get_data() noexcept -> ElementType* { return m_buffer.get(); }
-  constexpr auto get_data() const noexcept -> const ElementType* { return m_buffer.get(); }
+  constexpr auto get_data() noexcept -> ElementType* { return m_storage.data(); }
+  constexpr auto get_data() const noexcept -> const ElementType* { return m_storage.data(); }
+
+  [[nodiscard]] constexpr auto get_allocator() const noexcept -> Allocator { return Allocator{}; }
+
+  using Base::operator=;
 };
 
+// -------------------------------------------------------------------------------------------------
+// MdArray whose buffer is aligned to ALIGNMENT bytes, the alignment is exposed to the compiler via
+// the accessor.
+template <typename ElementType,
+          typename Extents,
+          size_t ALIGNMENT      = 64UZ,
+          typename LayoutPolicy = std::layout_right,
+          PageKind PAGES        = PageKind::DEFAULT>
+using AlignedMdArray = MdArray<ElementType,
+                               Extents,
+                               LayoutPolicy,
+                               aligned_accessor<ElementType, ALIGNMENT>,
+                               AlignedAllocator<ElementType, ALIGNMENT, PAGES>>;
+
+// -------------------------------------------------------------------------------------------------
+// MdArray of floats stored as float16 or bfloat16, see `reduced_precision_accessor`
+template <typename Storage, typename Extents, typename LayoutPolicy = std::layout_right>
+using ReducedPrecisionMdArray =
+    MdArray<float, Extents, LayoutPolicy, reduced_precision_accessor<Storage>>;
+
+// -------------------------------------------------------------------------------------------------
+// View of the elements of `span` with extents `n...` in the memory order of its layout, e.g. an
+// (nx * ny, nz) array as (nx, ny, nz). The number of elements must not change, which is checked at
+// compile time if all extents are static. Without explicit NewExtents, all new extents are dynamic.
+template <typename NewExtents, typename E, typename X, typename L, typename A, typename... Sizes>
+requires(detail::ReshapeableLayout<L> &&
+         (std::is_convertible_v<std::remove_cvref_t<Sizes>, typename NewExtents::size_type> && ...))
+[[nodiscard]] constexpr auto reshape(const std::mdspan<E, X, L, A>& span, Sizes... n)
+    -> std::mdspan<E, NewExtents, L, A> {
+  static_assert(detail::static_sizes_match<X, NewExtents>(),
+                "Reshaping must not change the number of elements.");
+  const typename L::template mapping<NewExtents> mapping{NewExtents(n...)};
+  IGOR_ASSERT(static_cast<size_t>(mapping.required_span_size()) == span.size(),
+              "Cannot reshape {} elements to extents with a different number of elements.",
+              span.size());
+  return {span.data_handle(), mapping, span.accessor()};
+}
+
+template <typename E, typename X, typename L, typename A, typename... Sizes>
+requires(sizeof...(Sizes) > 0UZ &&
+         (std::is_convertible_v<std::remove_cvref_t<Sizes>, typename X::index_type> && ...))
+[[nodiscard]] constexpr auto reshape(const std::mdspan<E, X, L, A>& span, Sizes... n) {
+  return reshape<std::dextents<typename X::index_type, sizeof...(Sizes)>>(span, n...);
+}
+
+namespace pmr {
+
+// MdArray that allocates from a `std::pmr::memory_resource`
+template <typename ElementType,
+          typename Extents,
+          typename LayoutPolicy   = std::layout_right,
+          typename AccessorPolicy = std::default_accessor<ElementType>>
+using MdArray = Igor::MdArray<ElementType,
+                              Extents,
+                              LayoutPolicy,
+                              AccessorPolicy,
+                              std::pmr::polymorphic_allocator<
+                                  detail::accessor_storage_t<AccessorPolicy>>>;
+
+}  // namespace pmr
+
 }  // namespace Igor
 
 #endif  // IGOR_MD_ARRAY_HPP_
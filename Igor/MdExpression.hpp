@@ -0,0 +1,415 @@
+#ifndef IGOR_MD_EXPRESSION_HPP_
+#define IGOR_MD_EXPRESSION_HPP_
+
+#include <array>
+#include <concepts>
+#include <mdspan>
+#include <type_traits>
+#include <utility>
+
+#include <Igor/BulkMemory.hpp>
+#include <Igor/Logging.hpp>
+#include <Igor/Math.hpp>
+#include <Igor/MdArray.hpp>
+
+namespace Igor {
+
+// =================================================================================================
+// Lazy elementwise expressions over MdArray and std::mdspan. Arithmetic on MdArrays, expressions
+// and scalars builds an expression tree that is only evaluated on assignment (`MdArray::operator=`
+// or `Igor::evaluate`), in one fused loop without temporaries. Plain std::mdspans have to be lifted
+// with `Igor::expr` first, as operators in namespace Igor are not found for them otherwise.
+// =================================================================================================
+
+template <typename Node>
+class MdExpr;
+
+namespace detail {
+
+// -------------------------------------------------------------------------------------------------
+template <typename E, typename X, typename L, typename A>
+void mdspan_base(const std::mdspan<E, X, L, A>&);
+
+// std::mdspan or a type derived from it like MdArray
+template <typename T>
+concept MdspanDerived = requires(const T& t) { detail::mdspan_base(t); };
+
+template <typename T>
+struct is_md_expr : std::false_type {};
+template <typename Node>
+struct is_md_expr<MdExpr<Node>> : std::true_type {};
+
+template <typename T>
+concept MdScalar = std::is_arithmetic_v<T>;
+
+template <typename T>
+concept MdOperand = is_md_expr<T>::value || MdspanDerived<T> || MdScalar<T>;
+
+// -------------------------------------------------------------------------------------------------
+// Extents of the result of combining two operands, static extents win over dynamic ones
+template <typename Extents1, typename Extents2>
+struct merge_extents {
+  static_assert(Extents1::rank() == Extents2::rank(), "Operands must have the same rank.");
+
+  static constexpr bool compatible = [] {
+    for (size_t r = 0; r < Extents1::rank(); ++r) {
+      if (Extents1::static_extent(r) != std::dynamic_extent &&
+          Extents2::static_extent(r) != std::dynamic_extent &&
+          Extents1::static_extent(r) != Extents2::static_extent(r)) {
+        return false;
+      }
+    }
+    return true;
+  }();
+  static_assert(compatible, "Static extents of the operands do not match.");
+
+  template <size_t... DIMS>
+  static auto make(std::index_sequence<DIMS...>)
+      -> std::extents<size_t,
+                      (Extents1::static_extent(DIMS) != std::dynamic_extent
+                           ? Extents1::static_extent(DIMS)
+                           : Extents2::static_extent(DIMS))...>;
+
+  using type = decltype(make(std::make_index_sequence<Extents1::rank()>{}));
+};
+
+// -------------------------------------------------------------------------------------------------
+// Expression nodes provide `value(idx...)` for a multi-index, `value_linear(i)` for the linear
+// index of exhaustive layout_left/layout_right data and `is_flat<Layout>` whether `value_linear`
+// can be used for all terminals in the tree.
+template <typename Mdspan>
+class MdTerminal {
+  Mdspan m_span;
+
+ public:
+  static constexpr bool is_scalar = false;
+  using extents_type              = typename Mdspan::extents_type;
+  using value_type                = typename Mdspan::value_type;
+
+  template <typename Layout>
+  static constexpr bool is_flat =
+      std::is_same_v<typename Mdspan::layout_type, Layout> && has_plain_accessor<Mdspan> &&
+      (std::is_same_v<Layout, std::layout_right> || std::is_same_v<Layout, std::layout_left>);
+
+  constexpr MdTerminal(const Mdspan& span) noexcept
+      : m_span(span) {}
+
+  [[nodiscard]] constexpr auto extents() const noexcept -> const extents_type& {
+    return m_span.extents();
+  }
+
+  template <typename... Idx>
+  [[nodiscard]] constexpr auto value(Idx... idx) const -> value_type {
+    return m_span[idx...];
+  }
+
+  [[nodiscard]] constexpr auto value_linear(size_t i) const -> value_type {
+    return m_span.data_handle()[i];  // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+  }
+};
+
+template <typename T>
+class MdScalarNode {
+  T m_value;
+
+ public:
+  static constexpr bool is_scalar = true;
+  using value_type                = T;
+
+  template <typename Layout>
+  static constexpr bool is_flat = true;
+
+  constexpr MdScalarNode(T value) noexcept
+      : m_value(value) {}
+
+  template <typename... Idx>
+  [[nodiscard]] constexpr auto value(Idx... /*idx*/) const noexcept -> value_type {
+    return m_value;
+  }
+  [[nodiscard]] constexpr auto value_linear(size_t /*i*/) const noexcept -> value_type {
+    return m_value;
+  }
+};
+
+template <typename Op, typename Arg>
+class MdUnary {
+  Arg m_arg;
+
+ public:
+  static constexpr bool is_scalar = false;
+  using extents_type              = typename Arg::extents_type;
+  using value_type = std::remove_cvref_t<decltype(Op{}(std::declval<typename Arg::value_type>()))>;
+
+  template <typename Layout>
+  static constexpr bool is_flat = Arg::template is_flat<Layout>;
+
+  constexpr MdUnary(Arg arg) noexcept
+      : m_arg(std::move(arg)) {}
+
+  [[nodiscard]] constexpr auto extents() const noexcept -> const extents_type& {
+    return m_arg.extents();
+  }
+
+  template <typename... Idx>
+  [[nodiscard]] constexpr auto value(Idx... idx) const -> value_type {
+    return Op{}(m_arg.value(idx...));
+  }
+  [[nodiscard]] constexpr auto value_linear(size_t i) const -> value_type {
+    return Op{}(m_arg.value_linear(i));
+  }
+};
+
+template <typename Lhs, typename Rhs>
+struct binary_extents;
+template <typename Lhs, typename Rhs>
+requires(!Lhs::is_scalar && !Rhs::is_scalar)
+struct binary_extents<Lhs, Rhs> {
+  using type = typename merge_extents<typename Lhs::extents_type, typename Rhs::extents_type>::type;
+};
+template <typename Lhs, typename Rhs>
+requires(Lhs::is_scalar)
+struct binary_extents<Lhs, Rhs> {
+  using type = typename Rhs::extents_type;
+};
+template <typename Lhs, typename Rhs>
+requires(!Lhs::is_scalar && Rhs::is_scalar)
+struct binary_extents<Lhs, Rhs> {
+  using type = typename Lhs::extents_type;
+};
+
+template <typename Op, typename Lhs, typename Rhs>
+class MdBinary {
+ public:
+  static constexpr bool is_scalar = false;
+  using extents_type              = typename binary_extents<Lhs, Rhs>::type;
+  using value_type                = std::remove_cvref_t<decltype(Op{}(
+      std::declval<typename Lhs::value_type>(), std::declval<typename Rhs::value_type>()))>;
+
+  template <typename Layout>
+  static constexpr bool is_flat = Lhs::template is_flat<Layout> && Rhs::template is_flat<Layout>;
+
+ private:
+  Lhs m_lhs;
+  Rhs m_rhs;
+  extents_type m_extents;
+
+  [[nodiscard]] static constexpr auto
+  init_extents(const Lhs& lhs, [[maybe_unused]] const Rhs& rhs) noexcept -> extents_type {
+    if constexpr (Lhs::is_scalar) {
+      return rhs.extents();
+    } else if constexpr (Rhs::is_scalar) {
+      return lhs.extents();
+    } else {
+      IGOR_ASSERT(lhs.extents() == rhs.extents(), "Extents of the operands do not match.");
+      return extents_type(lhs.extents());
+    }
+  }
+
+ public:
+  constexpr MdBinary(Lhs lhs, Rhs rhs) noexcept
+      : m_lhs(std::move(lhs)),
+        m_rhs(std::move(rhs)),
+        m_extents(init_extents(m_lhs, m_rhs)) {}
+
+  [[nodiscard]] constexpr auto extents() const noexcept -> const extents_type& {
+    return m_extents;
+  }
+
+  template <typename... Idx>
+  [[nodiscard]] constexpr auto value(Idx... idx) const -> value_type {
+    return Op{}(m_lhs.value(idx...), m_rhs.value(idx...));
+  }
+  [[nodiscard]] constexpr auto value_linear(size_t i) const -> value_type {
+    return Op{}(m_lhs.value_linear(i), m_rhs.value_linear(i));
+  }
+};
+
+// -------------------------------------------------------------------------------------------------
+struct Plus {
+  constexpr auto operator()(const auto& a, const auto& b) const noexcept { return a + b; }
+};
+struct Minus {
+  constexpr auto operator()(const auto& a, const auto& b) const noexcept { return a - b; }
+};
+struct Multiplies {
+  constexpr auto operator()(const auto& a, const auto& b) const noexcept { return a * b; }
+};
+struct Divides {
+  constexpr auto operator()(const auto& a, const auto& b) const noexcept { return a / b; }
+};
+struct Negate {
+  constexpr auto operator()(const auto& a) const noexcept { return -a; }
+};
+struct Sqrt {
+  constexpr auto operator()(const auto& a) const noexcept { return Igor::sqrt(a); }
+};
+struct Abs {
+  constexpr auto operator()(const auto& a) const noexcept { return Igor::abs(a); }
+};
+struct Sqr {
+  constexpr auto operator()(const auto& a) const noexcept { return Igor::sqr(a); }
+};
+
+// -------------------------------------------------------------------------------------------------
+template <typename Node>
+[[nodiscard]] constexpr auto to_node(const MdExpr<Node>& e) noexcept -> const Node& {
+  return e.node();
+}
+template <typename E, typename X, typename L, typename A>
+[[nodiscard]] constexpr auto to_node(const std::mdspan<E, X, L, A>& span) noexcept {
+  return MdTerminal<std::mdspan<E, X, L, A>>(span);
+}
+template <MdScalar T>
+[[nodiscard]] constexpr auto to_node(T value) noexcept {
+  return MdScalarNode<T>(value);
+}
+
+template <typename Op, typename Lhs, typename Rhs>
+[[nodiscard]] constexpr auto make_binary(const Lhs& lhs, const Rhs& rhs) {
+  using LhsNode = std::remove_cvref_t<decltype(to_node(lhs))>;
+  using RhsNode = std::remove_cvref_t<decltype(to_node(rhs))>;
+  return MdExpr<MdBinary<Op, LhsNode, RhsNode>>(
+      MdBinary<Op, LhsNode, RhsNode>(to_node(lhs), to_node(rhs)));
+}
+
+template <typename Op, typename Arg>
+[[nodiscard]] constexpr auto make_unary(const Arg& arg) {
+  using ArgNode = std::remove_cvref_t<decltype(to_node(arg))>;
+  return MdExpr<MdUnary<Op, ArgNode>>(MdUnary<Op, ArgNode>(to_node(arg)));
+}
+
+// At least one operand must be an array or expression, otherwise it is a plain scalar operation
+template <typename Lhs, typename Rhs>
+concept MdBinaryOperands =
+    MdOperand<Lhs> && MdOperand<Rhs> && (!MdScalar<Lhs> || !MdScalar<Rhs>);
+
+}  // namespace detail
+
+// -------------------------------------------------------------------------------------------------
+template <typename Node>
+class MdExpr {
+  Node m_node;
+
+ public:
+  using extents_type = typename Node::extents_type;
+  using value_type   = typename Node::value_type;
+
+  constexpr explicit MdExpr(Node node) noexcept
+      : m_node(std::move(node)) {}
+
+  [[nodiscard]] constexpr auto node() const noexcept -> const Node& { return m_node; }
+  [[nodiscard]] constexpr auto extents() const noexcept -> const extents_type& {
+    return m_node.extents();
+  }
+  [[nodiscard]] static constexpr auto rank() noexcept -> size_t { return extents_type::rank(); }
+  [[nodiscard]] constexpr auto extent(size_t r) const noexcept -> size_t {
+    return static_cast<size_t>(extents().extent(r));
+  }
+
+  template <typename... Idx>
+  requires(sizeof...(Idx) == extents_type::rank())
+  [[nodiscard]] constexpr auto operator[](Idx... idx) const -> value_type {
+    return m_node.value(idx...);
+  }
+};
+
+// -------------------------------------------------------------------------------------------------
+// Lift a std::mdspan into an expression
+template <typename E, typename X, typename L, typename A>
+[[nodiscard]] constexpr auto expr(const std::mdspan<E, X, L, A>& span) noexcept {
+  return MdExpr<detail::MdTerminal<std::mdspan<E, X, L, A>>>(span);
+}
+
+// -------------------------------------------------------------------------------------------------
+template <typename Lhs, typename Rhs>
+requires detail::MdBinaryOperands<Lhs, Rhs>
+[[nodiscard]] constexpr auto operator+(const Lhs& lhs, const Rhs& rhs) {
+  return detail::make_binary<detail::Plus>(lhs, rhs);
+}
+template <typename Lhs, typename Rhs>
+requires detail::MdBinaryOperands<Lhs, Rhs>
+[[nodiscard]] constexpr auto operator-(const Lhs& lhs, const Rhs& rhs) {
+  return detail::make_binary<detail::Minus>(lhs, rhs);
+}
+template <typename Lhs, typename Rhs>
+requires detail::MdBinaryOperands<Lhs, Rhs>
+[[nodiscard]] constexpr auto operator*(const Lhs& lhs, const Rhs& rhs) {
+  return detail::make_binary<detail::Multiplies>(lhs, rhs);
+}
+template <typename Lhs, typename Rhs>
+requires detail::MdBinaryOperands<Lhs, Rhs>
+[[nodiscard]] constexpr auto operator/(const Lhs& lhs, const Rhs& rhs) {
+  return detail::make_binary<detail::Divides>(lhs, rhs);
+}
+template <typename Arg>
+requires(detail::MdOperand<Arg> && !detail::MdScalar<Arg>)
+[[nodiscard]] constexpr auto operator-(const Arg& arg) {
+  return detail::make_unary<detail::Negate>(arg);
+}
+
+// -------------------------------------------------------------------------------------------------
+// Elementwise math functions. There are separate overloads for expressions, MdArrays and mdspans
+// s.t. they are more specialized than the scalar versions in Igor/Math.hpp.
+#define IGOR_MD_EXPRESSION_UNARY_FUNCTION(NAME, OP)                                                \
+  template <typename Node>                                                                         \
+  [[nodiscard]] constexpr auto NAME(const MdExpr<Node>& arg) {                                     \
+    return detail::make_unary<OP>(arg);                                                            \
+  }                                                                                                \
+  template <typename E, typename X, typename L, typename A, typename Alloc>                        \
+  [[nodiscard]] constexpr auto NAME(const MdArray<E, X, L, A, Alloc>& arg) {                       \
+    return detail::make_unary<OP>(arg);                                                            \
+  }                                                                                                \
+  template <typename E, typename X, typename L, typename A>                                        \
+  [[nodiscard]] constexpr auto NAME(const std::mdspan<E, X, L, A>& arg) {                          \
+    return detail::make_unary<OP>(arg);                                                            \
+  }
+
+// NOLINTBEGIN(cppcoreguidelines-macro-usage)
+IGOR_MD_EXPRESSION_UNARY_FUNCTION(sqrt, detail::Sqrt)
+IGOR_MD_EXPRESSION_UNARY_FUNCTION(abs, detail::Abs)
+IGOR_MD_EXPRESSION_UNARY_FUNCTION(sqr, detail::Sqr)
+// NOLINTEND(cppcoreguidelines-macro-usage)
+#undef IGOR_MD_EXPRESSION_UNARY_FUNCTION
+
+// -------------------------------------------------------------------------------------------------
+// Evaluate `e` into `dst` in one fused loop. If `dst` and all arrays in `e` share the same
+// layout_left or layout_right layout the loop runs over the linear index and vectorizes, otherwise
+// the loops are nested in the order of the layout of `dst`. Large arrays are split over threads.
+template <typename E, typename X, typename L, typename A, typename Node>
+void evaluate(const std::mdspan<E, X, L, A>& dst, const MdExpr<Node>& e) {
+  static_assert(X::rank() == Node::extents_type::rank(),
+                "Destination and expression must have the same rank.");
+  static_assert(detail::merge_extents<X, typename Node::extents_type>::compatible);
+  IGOR_ASSERT(dst.extents() == e.extents(), "Extents of destination and expression do not match.");
+
+  const Node& node   = e.node();
+  const size_t bytes = dst.size() * sizeof(E);
+  if constexpr (Node::template is_flat<L> &&
+                detail::has_plain_accessor<std::mdspan<E, X, L, A>>) {
+    E* out = dst.data_handle();
+    detail::for_each_block(dst.size(), bytes, [&](size_t begin, size_t end) {
+      for (size_t i = begin; i < end; ++i) {
+        out[i] = node.value_linear(i);  // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+      }
+    });
+  } else if constexpr (X::rank() == 0) {
+    dst[] = node.value();
+  } else {
+    constexpr bool left        = std::is_same_v<L, std::layout_left>;
+    constexpr size_t outer_dim = left ? X::rank() - 1UZ : 0UZ;
+    const auto assign          = [&](const auto& idx) {
+      [&]<size_t... DIMS>(std::index_sequence<DIMS...>) {
+        dst[idx[DIMS]...] = node.value(idx[DIMS]...);
+      }(std::make_index_sequence<X::rank()>{});
+    };
+    detail::for_each_block(
+        static_cast<size_t>(dst.extent(outer_dim)), bytes, [&](size_t begin, size_t end) {
+          std::array<typename X::index_type, X::rank()> idx{};
+          detail::nested_for<left>(dst.extents(), idx, begin, end, assign);
+        });
+  }
+}
+
+}  // namespace Igor
+
+#endif  // IGOR_MD_EXPRESSION_HPP_
@@ -0,0 +1,222 @@
+#ifndef IGOR_MD_ITERATOR_HPP_
+#define IGOR_MD_ITERATOR_HPP_
+
+#include <array>
+#include <compare>
+#include <cstddef>
+#include <iterator>
+#include <mdspan>
+#include <ranges>
+#include <span>
+#include <tuple>
+#include <type_traits>
+
+#include <Igor/MdAccessor.hpp>
+
+namespace Igor {
+
+// =================================================================================================
+// Iteration over all elements of an mdspan as a flat range, s.t. standard (parallel) algorithms and
+// ranges can be used directly. Exhaustive layouts with a plain accessor are a contiguous block of
+// memory and are iterated with pointers in memory order (`as_span`), all other mdspans with an
+// `MdIterator` over the multi-indices in the loop order of the layout (see `for_each_index`).
+// =================================================================================================
+
+namespace detail {
+
+// The elements of the mdspan are exactly the objects [data_handle(), data_handle() + size())
+template <typename Mdspan>
+concept ContiguousMdspan = has_plain_accessor<Mdspan> &&
+                           Mdspan::mapping_type::is_always_exhaustive() &&
+                           Mdspan::mapping_type::is_always_unique();
+
+// Same elements with read-only access, mdspans with proxy references are returned unchanged
+template <typename E, typename X, typename L, typename A>
+[[nodiscard]] constexpr auto as_const_mdspan(const std::mdspan<E, X, L, A>& span) noexcept {
+  if constexpr (has_plain_accessor<std::mdspan<E, X, L, A>>) {
+    return std::mdspan<const E, X, L>(span.data_handle(), span.mapping());
+  } else {
+    return span;
+  }
+}
+
+}  // namespace detail
+
+// -------------------------------------------------------------------------------------------------
+// Random access iterator over the elements of an mdspan in the loop order of its layout, i.e. the
+// first index varies fastest for layout_left and the last index for all other layouts. Increments
+// update the multi-index incrementally, jumps recompute it from the flat position. The iterator
+// is a C++17 random access iterator if the mdspan returns real references, otherwise only a C++20
+// random access iterator with proxy references.
+template <typename Mdspan>
+class MdIterator {
+  using extents_type  = typename Mdspan::extents_type;
+  using index_type    = typename extents_type::index_type;
+  using mapping_type  = typename Mdspan::mapping_type;
+  using accessor_type = typename Mdspan::accessor_type;
+
+  static constexpr size_t RANK = extents_type::rank();
+  static constexpr bool LEFT   = std::is_same_v<typename Mdspan::layout_type, std::layout_left>;
+
+ public:
+  using value_type        = std::remove_cv_t<typename Mdspan::element_type>;
+  using reference         = typename Mdspan::reference;
+  using difference_type   = std::ptrdiff_t;
+  using iterator_concept  = std::random_access_iterator_tag;
+  using iterator_category = std::conditional_t<std::is_reference_v<reference>,
+                                               std::random_access_iterator_tag,
+                                               std::input_iterator_tag>;
+
+ private:
+  typename Mdspan::data_handle_type m_data{};
+  mapping_type m_mapping{};
+  [[no_unique_address]] accessor_type m_accessor{};
+  std::array<index_type, RANK> m_idx{};
+  difference_type m_pos = 0;
+
+  // Dimension that varies `i`-th fastest
+  [[nodiscard]] static constexpr auto dim(size_t i) noexcept -> size_t {
+    return LEFT ? i : RANK - 1UZ - i;
+  }
+
+  constexpr void set_position(difference_type pos) noexcept {
+    m_pos = pos;
+    if (m_mapping.required_span_size() == 0) { return; }
+    auto rest = static_cast<size_t>(pos);
+    for (size_t i = 0; i < RANK; ++i) {
+      const auto n  = static_cast<size_t>(m_mapping.extents().extent(dim(i)));
+      m_idx[dim(i)] = static_cast<index_type>(rest % n);
+      rest /= n;
+    }
+  }
+
+ public:
+  constexpr MdIterator() noexcept = default;
+  constexpr MdIterator(const Mdspan& span, difference_type pos) noexcept
+      : m_data(span.data_handle()),
+        m_mapping(span.mapping()),
+        m_accessor(span.accessor()) {
+    set_position(pos);
+  }
+
+  // Multi-index of the element the iterator points to
+  [[nodiscard]] constexpr auto index() const noexcept -> const std::array<index_type, RANK>& {
+    return m_idx;
+  }
+
+  [[nodiscard]] constexpr auto operator*() const -> reference {
+    return m_accessor.access(m_data, static_cast<size_t>(std::apply(m_mapping, m_idx)));
+  }
+  [[nodiscard]] constexpr auto operator[](difference_type n) const -> reference {
+    return *(*this + n);
+  }
+
+  constexpr auto operator++() noexcept -> MdIterator& {
+    ++m_pos;
+    for (size_t i = 0; i < RANK; ++i) {
+      if (++m_idx[dim(i)] < m_mapping.extents().extent(dim(i))) { return *this; }
+      m_idx[dim(i)] = 0;
+    }
+    return *this;
+  }
+  constexpr auto operator--() noexcept -> MdIterator& {
+    --m_pos;
+    for (size_t i = 0; i < RANK; ++i) {
+      if (m_idx[dim(i)] > 0) {
+        --m_idx[dim(i)];
+        return *this;
+      }
+      m_idx[dim(i)] = m_mapping.extents().extent(dim(i)) - 1;
+    }
+    return *this;
+  }
+  constexpr auto operator++(int) noexcept -> MdIterator {
+    auto tmp = *this;
+    ++*this;
+    return tmp;
+  }
+  constexpr auto operator--(int) noexcept -> MdIterator {
+    auto tmp = *this;
+    --*this;
+    return tmp;
+  }
+
+  constexpr auto operator+=(difference_type n) noexcept -> MdIterator& {
+    set_position(m_pos + n);
+    return *this;
+  }
+  constexpr auto operator-=(difference_type n) noexcept -> MdIterator& {
+    set_position(m_pos - n);
+    return *this;
+  }
+  [[nodiscard]] friend constexpr auto operator+(MdIterator it, difference_type n) noexcept
+      -> MdIterator {
+    return it += n;
+  }
+  [[nodiscard]] friend constexpr auto operator+(difference_type n, MdIterator it) noexcept
+      -> MdIterator {
+    return it += n;
+  }
+  [[nodiscard]] friend constexpr auto operator-(MdIterator it, difference_type n) noexcept
+      -> MdIterator {
+    return it -= n;
+  }
+  [[nodiscard]] friend constexpr auto operator-(const MdIterator& lhs,
+                                                const MdIterator& rhs) noexcept
+      -> difference_type {
+    return lhs.m_pos - rhs.m_pos;
+  }
+
+  [[nodiscard]] friend constexpr auto operator==(const MdIterator& lhs,
+                                                 const MdIterator& rhs) noexcept -> bool {
+    return lhs.m_pos == rhs.m_pos;
+  }
+  [[nodiscard]] friend constexpr auto operator<=>(const MdIterator& lhs,
+                                                  const MdIterator& rhs) noexcept
+      -> std::strong_ordering {
+    return lhs.m_pos <=> rhs.m_pos;
+  }
+};
+
+// -------------------------------------------------------------------------------------------------
+// Range of all elements of an mdspan, see `MdIterator`
+template <typename Mdspan>
+class FlatView : public std::ranges::view_interface<FlatView<Mdspan>> {
+  Mdspan m_span;
+
+ public:
+  constexpr explicit FlatView(const Mdspan& span) noexcept
+      : m_span(span) {}
+
+  [[nodiscard]] constexpr auto begin() const noexcept -> MdIterator<Mdspan> {
+    return MdIterator<Mdspan>(m_span, 0);
+  }
+  [[nodiscard]] constexpr auto end() const noexcept -> MdIterator<Mdspan> {
+    return MdIterator<Mdspan>(m_span, static_cast<std::ptrdiff_t>(m_span.size()));
+  }
+  [[nodiscard]] constexpr auto size() const noexcept -> size_t { return m_span.size(); }
+};
+
+// -------------------------------------------------------------------------------------------------
+// The elements of a contiguous mdspan in memory order
+template <typename E, typename X, typename L, typename A>
+requires detail::ContiguousMdspan<std::mdspan<E, X, L, A>>
+[[nodiscard]] constexpr auto as_span(const std::mdspan<E, X, L, A>& span) noexcept
+    -> std::span<E> {
+  return std::span<E>(span.data_handle(), span.size());
+}
+
+// All elements of an mdspan as a range, a `std::span` in memory order for contiguous mdspans,
+// otherwise a `FlatView` in the loop order of the layout
+template <typename E, typename X, typename L, typename A>
+[[nodiscard]] constexpr auto flat_view(const std::mdspan<E, X, L, A>& span) noexcept {
+  if constexpr (detail::ContiguousMdspan<std::mdspan<E, X, L, A>>) {
+    return as_span(span);
+  } else {
+    return FlatView<std::mdspan<E, X, L, A>>(span);
+  }
+}
+
+}  // namespace Igor
+
+#endif  // IGOR_MD_ITERATOR_HPP_
@@ -1,25 +1,248 @@
 #ifndef IGOR_MDSPAN_TO_NPY_HPP_
 #define IGOR_MDSPAN_TO_NPY_HPP_
 
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cerrno>
+#include <charconv>
+#include <complex>
+#include <cstdint>
+#include <cstring>
 #include <fstream>
 #include <mdspan>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <vector>
 
+#include <Igor/ForEachIndex.hpp>
 #include <Igor/Logging.hpp>
+#include <Igor/MdAccessor.hpp>
+#include <Igor/ReducedPrecision.hpp>
 
 namespace Igor {
 
 namespace detail {
 
+// -------------------------------------------------------------------------------------------------
+// Complex numbers with float or double components, numpy's complex64 and complex128
+template <typename T>
+struct is_npy_complex : std::false_type {};
+template <typename T>
+requires std::is_same_v<T, float> || std::is_same_v<T, double>
+struct is_npy_complex<std::complex<T>> : std::true_type {};
+
+// Element types that are written to npy files without conversion
+template <typename T>
+concept NpyElement = std::is_same_v<std::remove_const_t<T>, float16> ||
+                     std::is_arithmetic_v<std::remove_const_t<T>> ||
+                     is_npy_complex<std::remove_const_t<T>>::value;
+
+// Byte order character of a multi-byte type with the byte order of the machine or the reverse one
+[[nodiscard]] constexpr auto npy_byte_order(bool swapped = false) noexcept -> char {
+  static_assert(std::endian::native == std::endian::little ||
+                    std::endian::native == std::endian::big,
+                "Mixed-endian machines are not supported.");
+  return (std::endian::native == std::endian::little) != swapped ? '<' : '>';
+}
+
+// -------------------------------------------------------------------------------------------------
+// Type description of the elements as used in the 'descr' entry of the npy header, elements are
+// stored with the byte order of the machine unless `swapped` is set
+template <typename T>
+[[nodiscard]] auto npy_descr(bool swapped = false) -> std::string {
+  using namespace std::string_literals;
+  static_assert(NpyElement<T>, "Unsupported element type.");
+  if constexpr (std::is_same_v<T, bool>) {
+    static_assert(sizeof(bool) == 1UZ, "npy requires one byte booleans.");
+    return "|b1";
+  } else if constexpr (std::is_same_v<T, float16>) {
+    return npy_byte_order(swapped) + "f2"s;
+  } else if constexpr (is_npy_complex<T>::value) {
+    return npy_byte_order(swapped) + "c"s + std::to_string(sizeof(T));
+  } else if constexpr (std::is_floating_point_v<T>) {
+    return npy_byte_order(swapped) + "f"s + std::to_string(sizeof(T));
+  } else {
+    const char kind = std::is_signed_v<T> ? 'i' : 'u';
+    if constexpr (sizeof(T) == 1UZ) {
+      return "|"s + kind + "1"s;
+    } else {
+      return npy_byte_order(swapped) + std::string(1UZ, kind) + std::to_string(sizeof(T));
+    }
+  }
+}
+
+// Reverse the byte order of `n` elements, complex numbers are swapped component-wise
+template <NpyElement T>
+void npy_byteswap(T* elements, size_t n) noexcept {
+  constexpr size_t component_size = is_npy_complex<T>::value ? sizeof(T) / 2UZ : sizeof(T);
+  auto* bytes                     = reinterpret_cast<unsigned char*>(elements);  // NOLINT
+  for (size_t i = 0; i < n * sizeof(T); i += component_size) {
+    std::reverse(bytes + i, bytes + i + component_size);  // NOLINT
+  }
+}
+
+// Type of the values in the npy file: float16 storage is written as is, bfloat16 is widened to
+// float as numpy has no bfloat16 type
+template <typename ElementType, typename AccessorPolicy>
+using npy_value_t =
+    std::conditional_t<std::is_same_v<std::remove_const_t<accessor_storage_t<AccessorPolicy>>,
+                                      float16>,
+                       float16,
+                       std::remove_const_t<ElementType>>;
+
+// Element type of staging buffers, bool is staged as bytes as std::vector<bool> is packed
+template <typename T>
+using npy_staging_t = std::conditional_t<std::is_same_v<T, bool>, unsigned char, T>;
+
+// -------------------------------------------------------------------------------------------------
+// Parsed header of an npy file, the payload starts `data_offset` bytes after the start of the file
+struct NpyHeader {
+  std::string descr{};
+  bool fortran_order = false;
+  std::vector<size_t> shape{};
+  size_t data_offset = 0;
+};
+
+// Text of the value of the entry `key` (including the quotes) in the header dictionary
+[[nodiscard]] constexpr auto npy_header_value(std::string_view dict, std::string_view key) noexcept
+    -> std::optional<std::string_view> {
+  auto pos = dict.find(key);
+  if (pos == std::string_view::npos) { return std::nullopt; }
+  pos = dict.find(':', pos + key.size());
+  if (pos == std::string_view::npos) { return std::nullopt; }
+
+  auto value = dict.substr(pos + 1UZ);
+  value.remove_prefix(std::min(value.find_first_not_of(' '), value.size()));
+  const auto end = value.starts_with('(') ? value.find(')') : value.find_first_of(",}");
+  if (end == std::string_view::npos) { return std::nullopt; }
+  value = value.substr(0, value.starts_with('(') ? end + 1UZ : end);
+  while (value.ends_with(' ')) {
+    value.remove_suffix(1);
+  }
+  return value;
+}
+
+// -------------------------------------------------------------------------------------------------
+// Parse the header at the start of `bytes` (format versions 1.0, 2.0 and 3.0)
+[[nodiscard]] inline auto parse_npy_header(std::string_view bytes,
+                                           const std::string& filename) noexcept
+    -> std::optional<NpyHeader> {
+  constexpr std::string_view magic_string = "\x93NUMPY";
+  if (!bytes.starts_with(magic_string) || bytes.size() < magic_string.size() + 4UZ) {
+    Igor::Warn("`{}` is not an npy file.", filename);
+    return std::nullopt;
+  }
+
+  // Header length is a little endian uint16 for version 1.0 and a uint32 for later versions
+  const auto major      = static_cast<unsigned char>(bytes[magic_string.size()]);
+  const size_t len_size = major == 1 ? 2UZ : 4UZ;
+  if (major < 1 || major > 3 || bytes.size() < magic_string.size() + 2UZ + len_size) {
+    Igor::Warn("Unsupported npy format version {} in `{}`.", major, filename);
+    return std::nullopt;
+  }
+  size_t header_len = 0;
+  for (size_t i = len_size; i-- > 0;) {
+    header_len = (header_len << 8UZ) |
+                 static_cast<unsigned char>(bytes[magic_string.size() + 2UZ + i]);
+  }
+  const size_t prefix_len = magic_string.size() + 2UZ + len_size;
+  if (bytes.size() < prefix_len + header_len) {
+    Igor::Warn("Header of `{}` is truncated.", filename);
+    return std::nullopt;
+  }
+  const auto dict = bytes.substr(prefix_len, header_len);
+
+  NpyHeader header{};
+  header.data_offset = prefix_len + header_len;
+
+  const auto descr = npy_header_value(dict, "'descr'");
+  if (!descr.has_value() || descr->size() < 2UZ) {
+    Igor::Warn("Header of `{}` has no valid 'descr' entry.", filename);
+    return std::nullopt;
+  }
+  header.descr = std::string{descr->substr(1UZ, descr->size() - 2UZ)};
+
+  const auto fortran_order = npy_header_value(dict, "'fortran_order'");
+  if (!fortran_order.has_value() || (*fortran_order != "True" && *fortran_order != "False")) {
+    Igor::Warn("Header of `{}` has no valid 'fortran_order' entry.", filename);
+    return std::nullopt;
+  }
+  header.fortran_order = *fortran_order == "True";
+
+  auto shape = npy_header_value(dict, "'shape'");
+  if (!shape.has_value() || !shape->starts_with('(')) {
+    Igor::Warn("Header of `{}` has no valid 'shape' entry.", filename);
+    return std::nullopt;
+  }
+  shape->remove_prefix(1);
+  while (!shape->empty()) {
+    shape->remove_prefix(std::min(shape->find_first_not_of(" ,)"), shape->size()));
+    if (shape->empty()) { break; }
+    size_t extent        = 0;
+    const auto [ptr, ec] = std::from_chars(shape->data(), shape->data() + shape->size(), extent);
+    if (ec != std::errc{}) {
+      Igor::Warn("Header of `{}` has an invalid 'shape' entry.", filename);
+      return std::nullopt;
+    }
+    header.shape.push_back(extent);
+    shape->remove_prefix(static_cast<size_t>(ptr - shape->data()));
+  }
+
+  return header;
+}
+
+// -------------------------------------------------------------------------------------------------
+// Check that the array described by `header` can be viewed as an mdspan with the given element
+// type, extents and layout
+template <typename ElementType, typename Extents, typename LayoutPolicy>
+[[nodiscard]] auto npy_header_matches(const NpyHeader& header, const std::string& filename) noexcept
+    -> bool {
+  if (header.descr != npy_descr<std::remove_const_t<ElementType>>()) {
+    Igor::Warn("`{}` contains elements of type '{}', expected '{}'.",
+               filename,
+               header.descr,
+               npy_descr<std::remove_const_t<ElementType>>());
+    return false;
+  }
+  if (header.fortran_order != std::is_same_v<LayoutPolicy, std::layout_left>) {
+    Igor::Warn("`{}` is stored in {} order, which does not match the layout.",
+               filename,
+               header.fortran_order ? "Fortran" : "C");
+    return false;
+  }
+  if (header.shape.size() != Extents::rank()) {
+    Igor::Warn("`{}` has rank {}, expected {}.", filename, header.shape.size(), Extents::rank());
+    return false;
+  }
+  for (size_t r = 0; r < Extents::rank(); ++r) {
+    if (Extents::static_extent(r) != std::dynamic_extent &&
+        Extents::static_extent(r) != header.shape[r]) {
+      Igor::Warn("Extent {} of `{}` is {}, expected {}.",
+                 r,
+                 filename,
+                 header.shape[r],
+                 Extents::static_extent(r));
+      return false;
+    }
+  }
+  return true;
+}
+
 // -------------------------------------------------------------------------------------------------
 // NOTE: Use const references for compatibility with Igor::MdArray
-template <std::floating_point Float, typename Extents, typename LayoutPolicy>
-[[nodiscard]] auto write_npy_header(std::ostream& out,
-                                    const std::mdspan<Float, Extents, LayoutPolicy>& data,
-                                    const std::string& filename) noexcept -> bool {
+template <NpyElement ElementType,
+          typename Extents,
+          typename LayoutPolicy,
+          typename AccessorPolicy>
+[[nodiscard]] auto write_npy_header(
+    std::ostream& out,
+    const std::mdspan<ElementType, Extents, LayoutPolicy, AccessorPolicy>& data,
+    const std::string& filename) noexcept -> bool {
   using namespace std::string_literals;
-  static_assert(std::is_same_v<LayoutPolicy, std::layout_right> ||
-                    std::is_same_v<LayoutPolicy, std::layout_left>,
-                "LayoutPolicy must be layout_left or layout_right");
 
   // Write magic string
   constexpr std::streamsize magic_string_len = 6;
@@ -42,10 +265,11 @@ template <std::floating_point Float, typename Extents, typename LayoutPolicy>
   std::string header = "{"s;
 
   // Data type
-  header += "'descr': '<f"s + std::to_string(sizeof(Float)) + "', "s;
-  // Data order, Fortran order (column major) or C order (row major)
+  header += "'descr': '"s + npy_descr<npy_value_t<ElementType, AccessorPolicy>>() + "', "s;
+  // Data order, Fortran order (column major) or C order (row major); layouts other than
+  // layout_left are written in C order
   header += "'fortran_order': "s +
-            (std::is_same_v<LayoutPolicy, std::layout_right> ? "False"s : "True"s) + ", "s;
+            (std::is_same_v<LayoutPolicy, std::layout_left> ? "True"s : "False"s) + ", "s;
   // Data shape
   IGOR_ASSERT(data.rank() >= 1UZ, "Rank must be at least one entry but is {}", data.rank());
   header += "'shape': ("s;
@@ -69,8 +293,12 @@ template <std::floating_point Float, typename Extents, typename LayoutPolicy>
   IGOR_ASSERT(
       header.size() <= std::numeric_limits<uint16_t>::max(),
       "Size cannot be larger than the max for an unsigned 16-bit integer as it is stored in one.");
-  const auto header_len = static_cast<uint16_t>(header.size());
-  if (!out.write(reinterpret_cast<const char*>(&header_len), header_len_len)) {  // NOLINT
+  // The header length is always little-endian, independent of the byte order of the data
+  const std::array<char, header_len_len> header_len{
+      static_cast<char>(header.size() & 0xFFUZ),
+      static_cast<char>((header.size() >> 8UZ) & 0xFFUZ),
+  };
+  if (!out.write(header_len.data(), header_len_len)) {
     Igor::Warn("Could not write header length to  {}: {}", filename, std::strerror(errno));
     return false;
   }
@@ -84,13 +312,138 @@ template <std::floating_point Float, typename Extents, typename LayoutPolicy>
   return true;
 }
 
+// Size of the staging buffers used to gather non-contiguous elements s.t. the file is written in
+// large blocks
+inline constexpr size_t NPY_STAGING_BYTES = 1UZ << 20UZ;
+
+// -------------------------------------------------------------------------------------------------
+// Whether the elements of the strided mapping are stored in C order without gaps, e.g. a slice
+// [i, :, :] of a layout_right mdspan; strides of extents equal to one are irrelevant
+template <typename Mapping>
+[[nodiscard]] constexpr auto is_c_contiguous(const Mapping& mapping) noexcept -> bool {
+  using index_type = typename Mapping::index_type;
+  index_type expected{1};
+  for (size_t r = Mapping::extents_type::rank(); r-- > 0;) {
+    const auto n = mapping.extents().extent(r);
+    if (n != 1 && mapping.stride(r) != expected) { return false; }
+    expected *= n;
+  }
+  return true;
+}
+
+// -------------------------------------------------------------------------------------------------
+// Write the elements of `data` in C order through a staging buffer of bounded size, for layouts
+// whose memory is not in C or Fortran order, e.g. `layout_blocked` or a layout_stride with a
+// non-unit stride in the last dimension. Throws if the staging buffer cannot be allocated.
+template <NpyElement ElementType,
+          typename Extents,
+          typename LayoutPolicy,
+          typename AccessorPolicy>
+[[nodiscard]] auto write_npy_data_staged(
+    std::ostream& out,
+    const std::mdspan<ElementType, Extents, LayoutPolicy, AccessorPolicy>& data,
+    const std::string& filename) -> bool {
+  using Value = npy_value_t<ElementType, AccessorPolicy>;
+  std::vector<npy_staging_t<Value>> staging;
+  staging.reserve(std::min(static_cast<size_t>(data.size()), NPY_STAGING_BYTES / sizeof(Value)));
+
+  bool success     = true;
+  const auto flush = [&] {
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+    if (success && !out.write(reinterpret_cast<const char*>(staging.data()),
+                              static_cast<std::streamsize>(staging.size() * sizeof(Value)))) {
+      Igor::Warn("Could not write data to `{}`: {}", filename, std::strerror(errno));
+      success = false;
+    }
+    staging.clear();
+  };
+  for_each_index<std::layout_right>(data.extents(), [&](auto... idx) {
+    if constexpr (std::is_same_v<Value, float16>) {
+      staging.push_back(from_float<float16>(data[idx...]));
+    } else {
+      staging.push_back(data[idx...]);
+    }
+    if (staging.size() == staging.capacity()) { flush(); }
+  });
+  flush();
+  return success;
+}
+
+// -------------------------------------------------------------------------------------------------
+// Write the elements of `data` in C order row by row, for strided layouts with contiguous rows like
+// `layout_padded` or a submdspan s.t. the gaps are skipped. Short rows are gathered in a staging
+// buffer and written together, rows longer than the buffer are written directly. Throws if the
+// staging buffer cannot be allocated.
+template <NpyElement ElementType,
+          typename Extents,
+          typename LayoutPolicy,
+          typename AccessorPolicy>
+[[nodiscard]] auto write_npy_data_rows(
+    std::ostream& out,
+    const std::mdspan<ElementType, Extents, LayoutPolicy, AccessorPolicy>& data,
+    const std::string& filename) -> bool {
+  using index_type      = typename Extents::index_type;
+  constexpr size_t rank = Extents::rank();
+  IGOR_ASSERT(data.stride(rank - 1UZ) == 1, "Rows must be contiguous.");
+
+  std::array<index_type, rank> begin{};
+  std::array<index_type, rank> end{};
+  for (size_t r = 0; r < rank; ++r) {
+    end[r] = data.extent(r);
+  }
+  end[rank - 1UZ]        = std::min(end[rank - 1UZ], index_type{1});
+  const auto row_size    = static_cast<size_t>(data.extent(rank - 1UZ));
+  const bool gather_rows = row_size > 0UZ && row_size * sizeof(ElementType) < NPY_STAGING_BYTES;
+  std::vector<npy_staging_t<std::remove_const_t<ElementType>>> staging;
+  if (gather_rows) {
+    staging.reserve(std::min(static_cast<size_t>(data.size()),
+                             NPY_STAGING_BYTES / sizeof(ElementType) / row_size * row_size));
+  }
+
+  bool success     = true;
+  const auto write = [&](const auto* elements, size_t n) {
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+    if (success && !out.write(reinterpret_cast<const char*>(elements),
+                              static_cast<std::streamsize>(n * sizeof(ElementType)))) {
+      Igor::Warn("Could not write data to `{}`: {}", filename, std::strerror(errno));
+      success = false;
+    }
+  };
+  const auto write_row = [&](const std::array<index_type, rank>& idx) {
+    const auto offset      = static_cast<size_t>(std::apply(data.mapping(), idx));
+    const ElementType* row = data.data_handle() + offset;  // NOLINT
+    if (!gather_rows) {
+      write(row, row_size);
+      return;
+    }
+    if (staging.size() + row_size > staging.capacity()) {
+      write(staging.data(), staging.size());
+      staging.clear();
+    }
+    staging.insert(staging.end(), row, row + row_size);  // NOLINT
+  };
+  std::array<index_type, rank> idx{};
+  nested_for_box<false>(begin, end, idx, write_row);
+  write(staging.data(), staging.size());
+  return success;
+}
+
 }  // namespace detail
 
 // -------------------------------------------------------------------------------------------------
+// Write `data` to the npy file `filename`. layout_right and layout_left (and strided views that
+// happen to be contiguous in C order) are written with a single write, other layouts like
+// layout_stride or submdspans are gathered in C order through a staging buffer of bounded size.
+// Floating point, integer, complex and bool elements are written as is in the byte order of the
+// machine, which is recorded in the header.
 // NOTE: Use const references for compatibility with Igor::MdArray
-template <std::floating_point Float, typename Extents, typename LayoutPolicy>
-[[nodiscard]] auto mdspan_to_npy(const std::mdspan<Float, Extents, LayoutPolicy>& data,
-                                 const std::string& filename) -> bool {
+template <detail::NpyElement ElementType,
+          typename Extents,
+          typename LayoutPolicy,
+          typename AccessorPolicy>
+[[nodiscard]] auto mdspan_to_npy(
+    const std::mdspan<ElementType, Extents, LayoutPolicy, AccessorPolicy>& data,
+    const std::string& filename) -> bool {
   std::ofstream out(filename, std::ios::binary | std::ios::out);
   if (!out) {
     Igor::Warn("Could not open file `{}`: {}", filename, std::strerror(errno));
@@ -99,14 +452,52 @@ template <std::floating_point Float, typename Extents, typename LayoutPolicy>
 
   if (!detail::write_npy_header(out, data, filename)) { return false; }
 
-  // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
-  if (!out.write(reinterpret_cast<const char*>(data.data_handle()),
-                 static_cast<std::streamsize>(data.size() * sizeof(Float)))) {
-    Igor::Warn("Could not write data to `{}`: {}", filename, std::strerror(errno));
-    return false;
+  using Mdspan = std::mdspan<ElementType, Extents, LayoutPolicy, AccessorPolicy>;
+  constexpr bool raw_half =
+      std::is_same_v<detail::npy_value_t<ElementType, AccessorPolicy>, float16>;
+  if constexpr (raw_half && (std::is_same_v<LayoutPolicy, std::layout_right> ||
+                             std::is_same_v<LayoutPolicy, std::layout_left>)) {
+    // float16 storage is written without conversion
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+    if (!out.write(reinterpret_cast<const char*>(data.data_handle()),
+                   static_cast<std::streamsize>(data.size() * sizeof(float16)))) {
+      Igor::Warn("Could not write data to `{}`: {}", filename, std::strerror(errno));
+      return false;
+    }
+    return true;
+  } else if constexpr (!detail::has_plain_accessor<Mdspan>) {
+    return detail::write_npy_data_staged(out, data, filename);
+  } else if constexpr (std::is_same_v<LayoutPolicy, std::layout_right> ||
+                       std::is_same_v<LayoutPolicy, std::layout_left>) {
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+    if (!out.write(reinterpret_cast<const char*>(data.data_handle()),
+                   static_cast<std::streamsize>(data.size() * sizeof(ElementType)))) {
+      Igor::Warn("Could not write data to `{}`: {}", filename, std::strerror(errno));
+      return false;
+    }
+    return true;
+  } else {
+    using Mapping = typename LayoutPolicy::template mapping<Extents>;
+    if constexpr (Extents::rank() > 0UZ && Mapping::is_always_strided()) {
+      // Strided views like layout_stride or submdspans can still be a contiguous block in C order
+      if (data.size() > 0UZ && detail::is_c_contiguous(data.mapping())) {
+        std::array<typename Extents::index_type, Extents::rank()> first{};
+        const auto offset        = static_cast<size_t>(std::apply(data.mapping(), first));
+        const ElementType* begin = data.data_handle() + offset;  // NOLINT
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+        if (!out.write(reinterpret_cast<const char*>(begin),
+                       static_cast<std::streamsize>(data.size() * sizeof(ElementType)))) {
+          Igor::Warn("Could not write data to `{}`: {}", filename, std::strerror(errno));
+          return false;
+        }
+        return true;
+      }
+      if (data.stride(Extents::rank() - 1UZ) == 1) {
+        return detail::write_npy_data_rows(out, data, filename);
+      }
+    }
+    return detail::write_npy_data_staged(out, data, filename);
   }
-
-  return true;
 }
 
 }  // namespace Igor
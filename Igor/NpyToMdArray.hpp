@@ -0,0 +1,176 @@
+#ifndef IGOR_NPY_TO_MD_ARRAY_HPP_
+#define IGOR_NPY_TO_MD_ARRAY_HPP_
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <mdspan>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+#include <Igor/Logging.hpp>
+#include <Igor/MappedMdArray.hpp>
+#include <Igor/MdArray.hpp>
+#include <Igor/MdspanToNpy.hpp>
+
+namespace Igor {
+
+namespace detail {
+
+// Longest header that is read, like numpy's limit for headers of untrusted files. Guards against
+// allocating the bogus length of a corrupt or malicious file.
+inline constexpr size_t NPY_MAX_HEADER_LEN = 10'000UZ;
+
+// -------------------------------------------------------------------------------------------------
+// Read and parse the header at the start of `in`, leaves the stream at the start of the payload
+[[nodiscard]] inline auto read_npy_header(std::istream& in, const std::string& filename) noexcept
+    -> std::optional<NpyHeader> {
+  // Magic string, version and a header length of two (version 1.0) or four bytes
+  constexpr size_t prefix_len = 6UZ + 2UZ + 4UZ;
+  std::string bytes(prefix_len, '\0');
+  in.read(bytes.data(), static_cast<std::streamsize>(prefix_len));
+  bytes.resize(static_cast<size_t>(in.gcount()));
+  if (bytes.size() < 10UZ) {
+    Igor::Warn("`{}` is not an npy file.", filename);
+    return std::nullopt;
+  }
+
+  const size_t len_size = static_cast<unsigned char>(bytes[6]) == 1 ? 2UZ : 4UZ;
+  size_t header_len     = 0;
+  for (size_t i = len_size; i-- > 0;) {
+    header_len = (header_len << 8UZ) | static_cast<unsigned char>(bytes[8UZ + i]);
+  }
+  if (header_len > NPY_MAX_HEADER_LEN) {
+    Igor::Warn("`{}` has a header of {} bytes, at most {} bytes are supported.",
+               filename,
+               header_len,
+               NPY_MAX_HEADER_LEN);
+    return std::nullopt;
+  }
+  const size_t read_len = 8UZ + len_size + header_len;
+  if (read_len > bytes.size()) {
+    const size_t old_size = bytes.size();
+    bytes.resize(read_len);
+    in.read(bytes.data() + old_size, static_cast<std::streamsize>(read_len - old_size));  // NOLINT
+    bytes.resize(old_size + static_cast<size_t>(in.gcount()));
+  }
+
+  auto header = parse_npy_header(bytes, filename);
+  if (header.has_value()) {
+    in.clear();
+    in.seekg(static_cast<std::streamoff>(header->data_offset));
+  }
+  return header;
+}
+
+// -------------------------------------------------------------------------------------------------
+// Size of the payload described by `header` in bytes, std::nullopt if it overflows or an extent
+// does not fit into the index type
+template <typename ElementType, typename Extents>
+[[nodiscard]] constexpr auto npy_payload_bytes(const NpyHeader& header) noexcept
+    -> std::optional<size_t> {
+  size_t bytes = sizeof(ElementType);
+  for (const size_t extent : header.shape) {
+    if (!std::in_range<typename Extents::index_type>(extent) ||
+        (extent != 0UZ && bytes > std::numeric_limits<size_t>::max() / extent)) {
+      return std::nullopt;
+    }
+    bytes *= extent;
+  }
+  return bytes;
+}
+
+}  // namespace detail
+
+// -------------------------------------------------------------------------------------------------
+// Read an npy file (format versions 1.0, 2.0 and 3.0, e.g. written by `mdspan_to_npy` or numpy)
+// into a new MdArray. The element type, memory order (layout_right for C order, layout_left for
+// Fortran order) and static extents must match the header, dynamic extents are taken from it. The
+// payload is read directly into the buffer of the array without intermediate copies, files with the
+// opposite byte order are swapped in place afterwards.
+template <typename ElementType, typename Extents, typename LayoutPolicy = std::layout_right>
+[[nodiscard]] auto npy_to_mdarray(const std::string& filename)
+    -> std::optional<MdArray<ElementType, Extents, LayoutPolicy>> {
+  static_assert(std::is_same_v<LayoutPolicy, std::layout_right> ||
+                    std::is_same_v<LayoutPolicy, std::layout_left>,
+                "npy files can only be read into layout_right or layout_left.");
+  static_assert(std::is_trivially_copyable_v<ElementType>,
+                "Element type must be trivially copyable.");
+
+  std::ifstream in(filename, std::ios::binary | std::ios::in);
+  if (!in) {
+    Igor::Warn("Could not open file `{}`: {}", filename, std::strerror(errno));
+    return std::nullopt;
+  }
+  auto header = detail::read_npy_header(in, filename);
+  const bool swapped =
+      header.has_value() && header->descr != detail::npy_descr<ElementType>() &&
+      header->descr == detail::npy_descr<ElementType>(true);
+  if (swapped) { header->descr = detail::npy_descr<ElementType>(); }
+  if (!header.has_value() ||
+      !detail::npy_header_matches<ElementType, Extents, LayoutPolicy>(*header, filename)) {
+    return std::nullopt;
+  }
+
+  // Check the shape against the size of the file before allocating, a corrupt or malicious header
+  // must not trigger a huge allocation
+  const auto bytes = detail::npy_payload_bytes<ElementType, Extents>(*header);
+  if (!bytes.has_value()) {
+    Igor::Warn("The shape of `{}` is too large.", filename);
+    return std::nullopt;
+  }
+  in.seekg(0, std::ios::end);
+  const std::streamoff end = in.tellg();
+  const size_t file_size   = end > 0 ? static_cast<size_t>(end) : 0UZ;
+  const size_t payload     = file_size - std::min(header->data_offset, file_size);
+  if (*bytes > payload) {
+    Igor::Warn("`{}` contains {} bytes of data, but {} bytes are required.",
+               filename,
+               payload,
+               *bytes);
+    return std::nullopt;
+  }
+  in.seekg(static_cast<std::streamoff>(header->data_offset));
+
+  // Elements that are not trivial like std::complex cannot be left uninitialized
+  auto res = [&]<size_t... DIMS>(std::index_sequence<DIMS...>) {
+    using Array = MdArray<ElementType, Extents, LayoutPolicy>;
+    if constexpr (std::is_trivial_v<ElementType>) {
+      return Array(uninitialized,
+                   static_cast<typename Extents::index_type>(header->shape[DIMS])...);
+    } else {
+      return Array(static_cast<typename Extents::index_type>(header->shape[DIMS])...);
+    }
+  }(std::make_index_sequence<Extents::rank()>{});
+
+  // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+  if (!in.read(reinterpret_cast<char*>(res.get_data()), static_cast<std::streamsize>(*bytes))) {
+    Igor::Warn("`{}` contains {} bytes of data, but {} bytes are required.",
+               filename,
+               in.gcount(),
+               *bytes);
+    return std::nullopt;
+  }
+  if (swapped) { detail::npy_byteswap(res.get_data(), res.size()); }
+  return res;
+}
+
+// -------------------------------------------------------------------------------------------------
+// Map an npy file instead of reading it, see `MappedMdArray::open_npy`. The elements are loaded
+// lazily by the kernel on first access; a const ElementType maps the file read-only, otherwise it
+// is mapped copy-on-write.
+template <typename ElementType, typename Extents, typename LayoutPolicy = std::layout_right>
+[[nodiscard]] auto map_npy(std::string filename) noexcept
+    -> std::optional<MappedMdArray<ElementType, Extents, LayoutPolicy>> {
+  return MappedMdArray<ElementType, Extents, LayoutPolicy>::open_npy(std::move(filename));
+}
+
+}  // namespace Igor
+
+#endif  // IGOR_NPY_TO_MD_ARRAY_HPP_
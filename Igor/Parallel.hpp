@@ -0,0 +1,79 @@
+#ifndef IGOR_PARALLEL_HPP_
+#define IGOR_PARALLEL_HPP_
+
+#include <algorithm>
+#include <atomic>
+#include <charconv>
+#include <cstddef>
+#include <cstdlib>
+#include <string_view>
+#include <thread>
+#include <utility>
+
+#include <Igor/ThreadPool.hpp>
+
+namespace Igor {
+
+namespace detail {
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+inline std::atomic<size_t> num_threads_override = 0;
+
+// Range of thread `thread_id` when distributing [begin, end) over `num_threads` threads in
+// contiguous blocks, identical to OpenMP's `schedule(static)`.
+[[nodiscard]] constexpr auto
+static_chunk(size_t begin, size_t end, size_t thread_id, size_t num_threads) noexcept
+    -> std::pair<size_t, size_t> {
+  const size_t n           = end - begin;
+  const size_t chunk       = n / num_threads;
+  const size_t remainder   = n % num_threads;
+  const size_t chunk_begin = begin + thread_id * chunk + std::min(thread_id, remainder);
+  return {chunk_begin, chunk_begin + chunk + (thread_id < remainder ? 1UZ : 0UZ)};
+}
+
+}  // namespace detail
+
+// -------------------------------------------------------------------------------------------------
+// Number of threads used by the parallel algorithms in Igor: the value set by `set_num_threads`,
+// otherwise `OMP_NUM_THREADS` s.t. Igor decomposes work like OpenMP kernels, otherwise the number
+// of hardware threads.
+[[nodiscard]] inline auto num_threads() noexcept -> size_t {
+  if (const size_t n = detail::num_threads_override.load(std::memory_order_relaxed); n > 0) {
+    return n;
+  }
+  // NOLINTNEXTLINE(concurrency-mt-unsafe)
+  if (const char* env = std::getenv("OMP_NUM_THREADS"); env != nullptr) {
+    const std::string_view env_str(env);
+    // Only the outermost level of a nested list like "8,2" is relevant
+    size_t n           = 0;
+    const auto [_, ec] = std::from_chars(env_str.data(), env_str.data() + env_str.size(), n);
+    if (ec == std::errc{} && n > 0) { return n; }
+  }
+  return std::max(static_cast<size_t>(std::thread::hardware_concurrency()), 1UZ);
+}
+
+inline void set_num_threads(size_t n) noexcept {
+  detail::num_threads_override.store(n, std::memory_order_relaxed);
+}
+
+// -------------------------------------------------------------------------------------------------
+// Call `f(i)` for all i in [begin, end), the range is split in contiguous blocks over `n_threads`
+// threads of a persistent thread pool like OpenMP's `schedule(static)`. Nested calls run
+// sequentially on the calling thread. `f` must not throw.
+template <typename F>
+void parallel_for(size_t begin, size_t end, F&& f, size_t n_threads = num_threads()) noexcept {
+  if (begin >= end) { return; }
+  n_threads = std::clamp(n_threads, 1UZ, end - begin);
+
+  auto run_chunk = [&](size_t thread_id) {
+    const auto [chunk_begin, chunk_end] = detail::static_chunk(begin, end, thread_id, n_threads);
+    for (size_t i = chunk_begin; i < chunk_end; ++i) {
+      f(i);
+    }
+  };
+  detail::ThreadPool::instance().run(n_threads, run_chunk);
+}
+
+}  // namespace Igor
+
+#endif  // IGOR_PARALLEL_HPP_
@@ -22,20 +22,39 @@
 #ifndef IGOR_PROGRESS_BAR_HPP_
 #define IGOR_PROGRESS_BAR_HPP_
 
+#include <algorithm>
 #include <cassert>
+#include <cstddef>
 #include <iomanip>
 #include <iostream>
+#include <string>
 
 namespace Igor {
 
+namespace detail {
+
+template <typename ProgressType>
+void show_progress(std::size_t length, ProgressType progress, ProgressType max_progress) noexcept {
+  enum : char { DONE_CHAR = '#', NOT_DONE_CHAR = '.' };
+
+  const auto done_length =
+      static_cast<std::size_t>((static_cast<ProgressType>(length) * progress) / max_progress);
+  const auto done_prct = static_cast<std::size_t>((100 * progress) / max_progress);
+  std::cout << "\r[";
+  std::cout << std::string(done_length, DONE_CHAR);
+  std::cout << std::string(length - done_length, NOT_DONE_CHAR);
+  std::cout << "] ";
+  std::cout << std::setw(3) << done_prct << "%" << std::flush;
+}
+
+}  // namespace detail
+
 template <typename ProgressType = std::size_t>
 class ProgressBar {
   std::size_t m_length;
   ProgressType m_max_progress;
   ProgressType m_progress = 0;
 
-  enum : char { DONE_CHAR = '#', NOT_DONE_CHAR = '.' };
-
  public:
   constexpr ProgressBar(ProgressType max_progress, std::size_t length) noexcept
       : m_length(length - 5UZ),
@@ -46,16 +65,7 @@ class ProgressBar {
     show();
   }
 
-  void show() const noexcept {
-    const auto done_length = static_cast<std::size_t>(
-        (static_cast<ProgressType>(m_length) * m_progress) / m_max_progress);
-    const auto done_prct = static_cast<std::size_t>((100 * m_progress) / m_max_progress);
-    std::cout << "\r[";
-    std::cout << std::string(done_length, DONE_CHAR);
-    std::cout << std::string(m_length - done_length, NOT_DONE_CHAR);
-    std::cout << "] ";
-    std::cout << std::setw(3) << done_prct << "%" << std::flush;
-  }
+  void show() const noexcept { detail::show_progress(m_length, m_progress, m_max_progress); }
 };
 
 }  // namespace Igor
@@ -0,0 +1,366 @@
+#ifndef IGOR_REDUCE_HPP_
+#define IGOR_REDUCE_HPP_
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <limits>
+#include <mdspan>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#if __has_include(<experimental/simd>)
+#include <experimental/simd>
+#define IGOR_HAS_STD_SIMD
+#endif  // __has_include(<experimental/simd>)
+
+#include <Igor/ForEachIndex.hpp>
+#include <Igor/Logging.hpp>
+#include <Igor/MdAccessor.hpp>
+#include <Igor/Parallel.hpp>
+
+namespace Igor {
+
+// =================================================================================================
+// Reductions over std::mdspan and MdArray. Exhaustive layout_left/layout_right data with a plain
+// accessor is reduced in one linear SIMD loop (std::experimental::simd if available, otherwise a
+// scalar loop with independent accumulators), everything else in a nested multi-index loop.
+// All reductions optionally split the work over `n_threads` threads; the partial results are
+// combined in thread order, so the result is deterministic for a fixed number of threads.
+// =================================================================================================
+
+namespace detail {
+
+#ifdef IGOR_HAS_STD_SIMD
+namespace stdx = std::experimental;
+
+template <typename T>
+concept SimdReducible = std::is_arithmetic_v<T> && !std::is_same_v<T, bool>;
+#else
+template <typename T>
+concept SimdReducible = false;
+#endif  // IGOR_HAS_STD_SIMD
+
+// Number of independent vector accumulators, hides the latency of the add/max instructions
+inline constexpr size_t REDUCE_UNROLL = 4UZ;
+
+// -------------------------------------------------------------------------------------------------
+// Elementwise helpers that work for scalars and SIMD vectors
+template <typename V>
+[[nodiscard]] constexpr auto reduce_abs(V x) noexcept -> V {
+  if constexpr (std::is_unsigned_v<V>) {
+    return x;
+  } else if constexpr (std::is_arithmetic_v<V>) {
+    return x < V{0} ? -x : x;
+  } else {
+#ifdef IGOR_HAS_STD_SIMD
+    if constexpr (!std::is_unsigned_v<typename V::value_type>) {
+      where(x < V(0), x) = -x;
+    }
+#endif  // IGOR_HAS_STD_SIMD
+    return x;
+  }
+}
+
+template <typename V>
+[[nodiscard]] constexpr auto reduce_min(V a, V b) noexcept -> V {
+  if constexpr (std::is_arithmetic_v<V>) {
+    return std::min(a, b);
+  } else {
+#ifdef IGOR_HAS_STD_SIMD
+    return stdx::min(a, b);
+#endif  // IGOR_HAS_STD_SIMD
+  }
+}
+
+template <typename V>
+[[nodiscard]] constexpr auto reduce_max(V a, V b) noexcept -> V {
+  if constexpr (std::is_arithmetic_v<V>) {
+    return std::max(a, b);
+  } else {
+#ifdef IGOR_HAS_STD_SIMD
+    return stdx::max(a, b);
+#endif  // IGOR_HAS_STD_SIMD
+  }
+}
+
+// -------------------------------------------------------------------------------------------------
+// A reduction operation provides the accumulator type `acc<V>` for element type (or vector type)
+// V, its `identity`, the elementwise `step`, `combine` of two accumulators and `horizontal` to
+// reduce a vector accumulator to a scalar one.
+template <typename T>
+struct SumOp {
+  template <typename V>
+  using acc = V;
+  template <typename V>
+  [[nodiscard]] static constexpr auto identity() noexcept -> V {
+    return V(T{0});
+  }
+  template <typename V>
+  [[nodiscard]] static constexpr auto step(V sum, V x) noexcept -> V {
+    return sum + x;
+  }
+  template <typename V>
+  [[nodiscard]] static constexpr auto combine(V a, V b) noexcept -> V {
+    return a + b;
+  }
+#ifdef IGOR_HAS_STD_SIMD
+  template <typename V>
+  [[nodiscard]] static constexpr auto horizontal(V sum) noexcept -> T {
+    return stdx::reduce(sum);
+  }
+#endif  // IGOR_HAS_STD_SIMD
+};
+
+template <typename T>
+struct SumSquaresOp : SumOp<T> {
+  template <typename V>
+  [[nodiscard]] static constexpr auto step(V sum, V x) noexcept -> V {
+    return sum + x * x;
+  }
+};
+
+template <typename T>
+struct DotOp : SumOp<T> {
+  template <typename V>
+  [[nodiscard]] static constexpr auto step(V sum, V x, V y) noexcept -> V {
+    return sum + x * y;
+  }
+};
+
+template <typename T>
+struct MaxAbsOp {
+  template <typename V>
+  using acc = V;
+  template <typename V>
+  [[nodiscard]] static constexpr auto identity() noexcept -> V {
+    return V(T{0});
+  }
+  template <typename V>
+  [[nodiscard]] static constexpr auto step(V max, V x) noexcept -> V {
+    return reduce_max(max, reduce_abs(x));
+  }
+  template <typename V>
+  [[nodiscard]] static constexpr auto combine(V a, V b) noexcept -> V {
+    return reduce_max(a, b);
+  }
+#ifdef IGOR_HAS_STD_SIMD
+  template <typename V>
+  [[nodiscard]] static constexpr auto horizontal(V max) noexcept -> T {
+    return stdx::hmax(max);
+  }
+#endif  // IGOR_HAS_STD_SIMD
+};
+
+template <typename T>
+struct MinMaxOp {
+  template <typename V>
+  using acc = std::pair<V, V>;
+  template <typename V>
+  [[nodiscard]] static constexpr auto identity() noexcept -> acc<V> {
+    return {V(std::numeric_limits<T>::max()), V(std::numeric_limits<T>::lowest())};
+  }
+  template <typename V>
+  [[nodiscard]] static constexpr auto step(acc<V> a, V x) noexcept -> acc<V> {
+    return {reduce_min(a.first, x), reduce_max(a.second, x)};
+  }
+  template <typename V>
+  [[nodiscard]] static constexpr auto combine(acc<V> a, acc<V> b) noexcept -> acc<V> {
+    return {reduce_min(a.first, b.first), reduce_max(a.second, b.second)};
+  }
+#ifdef IGOR_HAS_STD_SIMD
+  template <typename V>
+  [[nodiscard]] static constexpr auto horizontal(acc<V> a) noexcept -> acc<T> {
+    return {stdx::hmin(a.first), stdx::hmax(a.second)};
+  }
+#endif  // IGOR_HAS_STD_SIMD
+};
+
+// -------------------------------------------------------------------------------------------------
+// Reduce the elements [begin, end) of the contiguous arrays `data...` with `Op`
+// NOLINTBEGIN(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+template <typename Op, typename T, typename... Ts>
+[[nodiscard]] auto reduce_contiguous(size_t begin, size_t end, const T* data, const Ts*... rest)
+    -> typename Op::template acc<T> {
+  static_assert((std::is_same_v<T, Ts> && ...), "All operands must have the same element type.");
+
+  auto result = Op::template identity<T>();
+  size_t i    = begin;
+#ifdef IGOR_HAS_STD_SIMD
+  if constexpr (SimdReducible<T>) {
+    using V               = stdx::native_simd<T>;
+    constexpr size_t VEC  = V::size();
+    constexpr size_t STEP = REDUCE_UNROLL * VEC;
+
+    std::array<typename Op::template acc<V>, REDUCE_UNROLL> accs{};
+    std::ranges::fill(accs, Op::template identity<V>());
+    for (; i + STEP <= end; i += STEP) {
+      for (size_t u = 0; u < REDUCE_UNROLL; ++u) {
+        const size_t offset = i + u * VEC;
+        accs[u]             = Op::step(accs[u],
+                               V(data + offset, stdx::element_aligned),
+                               V(rest + offset, stdx::element_aligned)...);
+      }
+    }
+    for (; i + VEC <= end; i += VEC) {
+      accs[0] = Op::step(
+          accs[0], V(data + i, stdx::element_aligned), V(rest + i, stdx::element_aligned)...);
+    }
+    for (size_t u = 1; u < REDUCE_UNROLL; ++u) {
+      accs[0] = Op::combine(accs[0], accs[u]);
+    }
+    result = Op::horizontal(accs[0]);
+  }
+#else
+  // Independent accumulators allow the compiler to vectorize and pipeline the loop without
+  // reassociating floating point operations
+  if constexpr (std::is_arithmetic_v<T>) {
+    std::array<typename Op::template acc<T>, REDUCE_UNROLL> accs{};
+    std::ranges::fill(accs, Op::template identity<T>());
+    for (; i + REDUCE_UNROLL <= end; i += REDUCE_UNROLL) {
+      for (size_t u = 0; u < REDUCE_UNROLL; ++u) {
+        accs[u] = Op::step(accs[u], data[i + u], rest[i + u]...);
+      }
+    }
+    for (size_t u = 0; u < REDUCE_UNROLL; ++u) {
+      result = Op::combine(result, accs[u]);
+    }
+  }
+#endif  // IGOR_HAS_STD_SIMD
+  for (; i < end; ++i) {
+    result = Op::step(result, data[i], rest[i]...);
+  }
+  return result;
+}
+// NOLINTEND(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+
+// -------------------------------------------------------------------------------------------------
+// Split [0, n) over `n_threads` threads, reduce each block with `block(begin, end)` and combine the
+// partial results in thread order
+template <typename Op, typename T, typename F>
+[[nodiscard]] auto parallel_reduce(size_t n, size_t n_threads, F&& block)
+    -> typename Op::template acc<T> {
+  n_threads = std::clamp(n_threads, 1UZ, std::max(n, 1UZ));
+  if (n_threads == 1UZ) { return block(0UZ, n); }
+
+  std::vector<typename Op::template acc<T>> partial(n_threads);
+  parallel_for(
+      0UZ,
+      n_threads,
+      [&](size_t thread_id) {
+        const auto [begin, end] = static_chunk(0UZ, n, thread_id, n_threads);
+        partial[thread_id]      = block(begin, end);
+      },
+      n_threads);
+
+  auto result = Op::template identity<T>();
+  for (const auto& p : partial) {
+    result = Op::combine(result, p);
+  }
+  return result;
+}
+
+template <typename Mdspan>
+inline constexpr bool is_contiguous_mdspan =
+    (std::is_same_v<typename Mdspan::layout_type, std::layout_right> ||
+     std::is_same_v<typename Mdspan::layout_type, std::layout_left>) &&
+    has_plain_accessor<Mdspan>;
+
+// -------------------------------------------------------------------------------------------------
+// Reduce the mdspans `span, rest...` of identical extents with `Op`
+template <typename Op, typename Span, typename... Spans>
+[[nodiscard]] auto reduce_mdspan(size_t n_threads, const Span& span, const Spans&... rest) {
+  using T                = std::remove_cv_t<typename Span::element_type>;
+  using Extents          = typename Span::extents_type;
+  constexpr size_t rank  = Extents::rank();
+  constexpr bool is_left = std::is_same_v<typename Span::layout_type, std::layout_left>;
+  IGOR_ASSERT(((span.extents() == rest.extents()) && ...),
+              "Extents of the operands do not match.");
+
+  constexpr bool same_layout =
+      (std::is_same_v<typename Span::layout_type, typename Spans::layout_type> && ...);
+  constexpr bool contiguous = is_contiguous_mdspan<Span> && (is_contiguous_mdspan<Spans> && ...) &&
+                              (rank <= 1UZ || same_layout);
+  if constexpr (contiguous) {
+    return parallel_reduce<Op, T>(span.size(), n_threads, [&](size_t begin, size_t end) {
+      return reduce_contiguous<Op>(begin, end, span.data_handle(), rest.data_handle()...);
+    });
+  } else if constexpr (rank == 0UZ) {
+    return Op::step(Op::template identity<T>(), T{span[]}, T{rest[]}...);
+  } else {
+    // Split the outermost dimension (w.r.t. the memory layout of the first operand) over threads
+    constexpr size_t outer_dim = is_left ? rank - 1UZ : 0UZ;
+    return parallel_reduce<Op, T>(
+        static_cast<size_t>(span.extent(outer_dim)), n_threads, [&](size_t begin, size_t end) {
+          auto result  = Op::template identity<T>();
+          const auto f = [&](const std::array<typename Extents::index_type, rank>& idx) {
+            result = Op::step(result, T{span[idx]}, T{rest[idx]}...);
+          };
+          std::array<typename Extents::index_type, rank> idx{};
+          nested_for<is_left>(span.extents(), idx, begin, end, f);
+          return result;
+        });
+  }
+}
+
+}  // namespace detail
+
+// -------------------------------------------------------------------------------------------------
+// Sum of all elements
+template <typename E, typename X, typename L, typename A>
+[[nodiscard]] auto sum(const std::mdspan<E, X, L, A>& span, size_t n_threads = 1UZ)
+    -> std::remove_cv_t<E> {
+  return detail::reduce_mdspan<detail::SumOp<std::remove_cv_t<E>>>(n_threads, span);
+}
+
+// -------------------------------------------------------------------------------------------------
+// Maximum absolute value of all elements (the maximum norm), zero for empty mdspans
+template <typename E, typename X, typename L, typename A>
+[[nodiscard]] auto max_abs(const std::mdspan<E, X, L, A>& span, size_t n_threads = 1UZ)
+    -> std::remove_cv_t<E> {
+  return detail::reduce_mdspan<detail::MaxAbsOp<std::remove_cv_t<E>>>(n_threads, span);
+}
+
+// -------------------------------------------------------------------------------------------------
+// Euclidean norm of all elements
+template <typename E, typename X, typename L, typename A>
+requires std::floating_point<std::remove_cv_t<E>>
+[[nodiscard]] auto l2_norm(const std::mdspan<E, X, L, A>& span, size_t n_threads = 1UZ)
+    -> std::remove_cv_t<E> {
+  return std::sqrt(
+      detail::reduce_mdspan<detail::SumSquaresOp<std::remove_cv_t<E>>>(n_threads, span));
+}
+
+// -------------------------------------------------------------------------------------------------
+// Sum of the elementwise product of two mdspans with identical extents
+template <typename E1,
+          typename X1,
+          typename L1,
+          typename A1,
+          typename E2,
+          typename X2,
+          typename L2,
+          typename A2>
+requires std::same_as<std::remove_cv_t<E1>, std::remove_cv_t<E2>>
+[[nodiscard]] auto dot(const std::mdspan<E1, X1, L1, A1>& a,
+                       const std::mdspan<E2, X2, L2, A2>& b,
+                       size_t n_threads = 1UZ) -> std::remove_cv_t<E1> {
+  static_assert(X1::rank() == X2::rank(), "Operands must have the same rank.");
+  return detail::reduce_mdspan<detail::DotOp<std::remove_cv_t<E1>>>(n_threads, a, b);
+}
+
+// -------------------------------------------------------------------------------------------------
+// Smallest and largest element of a non-empty mdspan
+template <typename E, typename X, typename L, typename A>
+[[nodiscard]] auto minmax(const std::mdspan<E, X, L, A>& span, size_t n_threads = 1UZ)
+    -> std::pair<std::remove_cv_t<E>, std::remove_cv_t<E>> {
+  IGOR_ASSERT(span.size() > 0, "Cannot compute the minimum and maximum of an empty mdspan.");
+  return detail::reduce_mdspan<detail::MinMaxOp<std::remove_cv_t<E>>>(n_threads, span);
+}
+
+}  // namespace Igor
+
+#endif  // IGOR_REDUCE_HPP_
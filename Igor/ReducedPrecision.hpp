@@ -0,0 +1,244 @@
+#ifndef IGOR_REDUCED_PRECISION_HPP_
+#define IGOR_REDUCED_PRECISION_HPP_
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#if defined(__F16C__)
+#include <immintrin.h>
+#endif  // __F16C__
+
+namespace Igor {
+
+// =================================================================================================
+// Storage of floating point values in 16 bits, computations happen in float. `float16` is IEEE
+// binary16 (numpy's float16), `bfloat16` keeps the exponent range of float with a 7 bit mantissa.
+// Conversions from float round to nearest even.
+// =================================================================================================
+
+struct float16 {
+  std::uint16_t bits;
+};
+
+struct bfloat16 {
+  std::uint16_t bits;
+};
+
+namespace detail {
+
+template <typename T>
+concept ReducedPrecision = std::is_same_v<T, float16> || std::is_same_v<T, bfloat16>;
+
+// Software conversions, see https://gist.github.com/rygorous/2156668
+[[nodiscard]] constexpr auto half_bits_to_float(std::uint16_t h) noexcept -> float {
+  constexpr std::uint32_t magic       = 113U << 23U;
+  constexpr std::uint32_t shifted_exp = 0x7C00U << 13U;
+
+  std::uint32_t bits      = (h & 0x7FFFU) << 13U;
+  const std::uint32_t exp = shifted_exp & bits;
+  bits += (127U - 15U) << 23U;
+  if (exp == shifted_exp) {
+    // Inf or NaN
+    bits += (128U - 16U) << 23U;
+  } else if (exp == 0U) {
+    // Zero or subnormal, renormalize via a float subtraction
+    bits += 1U << 23U;
+    bits = std::bit_cast<std::uint32_t>(std::bit_cast<float>(bits) - std::bit_cast<float>(magic));
+  }
+  return std::bit_cast<float>(bits | ((h & 0x8000U) << 16U));
+}
+
+[[nodiscard]] constexpr auto float_to_half_bits(float f) noexcept -> std::uint16_t {
+  constexpr std::uint32_t f32_infinity = 255U << 23U;
+  constexpr std::uint32_t f16_max      = (127U + 16U) << 23U;
+  constexpr std::uint32_t denorm_magic = ((127U - 15U) + (23U - 10U) + 1U) << 23U;
+
+  std::uint32_t bits       = std::bit_cast<std::uint32_t>(f);
+  const std::uint32_t sign = bits & 0x80000000U;
+  bits ^= sign;
+
+  std::uint32_t res = 0;
+  if (bits >= f16_max) {
+    // Overflow to Inf, NaN stays a quiet NaN
+    res = bits > f32_infinity ? 0x7E00U : 0x7C00U;
+  } else if (bits < (113U << 23U)) {
+    // Subnormal or zero, the float addition rounds the mantissa into place
+    res = std::bit_cast<std::uint32_t>(std::bit_cast<float>(bits) +
+                                       std::bit_cast<float>(denorm_magic)) -
+          denorm_magic;
+  } else {
+    const std::uint32_t mantissa_odd = (bits >> 13U) & 1U;
+    bits += ((15U - 127U) << 23U) + 0xFFFU;
+    bits += mantissa_odd;
+    res = bits >> 13U;
+  }
+  return static_cast<std::uint16_t>(res | (sign >> 16U));
+}
+
+[[nodiscard]] constexpr auto bfloat16_bits_to_float(std::uint16_t b) noexcept -> float {
+  return std::bit_cast<float>(static_cast<std::uint32_t>(b) << 16U);
+}
+
+[[nodiscard]] constexpr auto float_to_bfloat16_bits(float f) noexcept -> std::uint16_t {
+  const auto bits = std::bit_cast<std::uint32_t>(f);
+  if ((bits & 0x7FFFFFFFU) > 0x7F800000U) {
+    // Keep NaNs quiet instead of rounding them to Inf
+    return static_cast<std::uint16_t>((bits >> 16U) | 0x40U);
+  }
+  return static_cast<std::uint16_t>((bits + 0x7FFFU + ((bits >> 16U) & 1U)) >> 16U);
+}
+
+}  // namespace detail
+
+// -------------------------------------------------------------------------------------------------
+[[nodiscard]] constexpr auto to_float(float16 h) noexcept -> float {
+#if defined(__F16C__)
+  if !consteval { return _cvtsh_ss(h.bits); }
+#endif  // __F16C__
+  return detail::half_bits_to_float(h.bits);
+}
+[[nodiscard]] constexpr auto to_float(bfloat16 b) noexcept -> float {
+  return detail::bfloat16_bits_to_float(b.bits);
+}
+
+template <detail::ReducedPrecision Storage>
+[[nodiscard]] constexpr auto from_float(float f) noexcept -> Storage {
+  if constexpr (std::is_same_v<Storage, float16>) {
+#if defined(__F16C__)
+    if !consteval { return float16{_cvtss_sh(f, _MM_FROUND_TO_NEAREST_INT)}; }
+#endif  // __F16C__
+    return float16{detail::float_to_half_bits(f)};
+  } else {
+    return bfloat16{detail::float_to_bfloat16_bits(f)};
+  }
+}
+
+// -------------------------------------------------------------------------------------------------
+// Bulk conversion of `n` values, float16 uses the F16C instructions if available, the bfloat16
+// conversion is plain integer arithmetic the compiler vectorizes.
+template <detail::ReducedPrecision Storage>
+void convert_n(const Storage* src, size_t n, float* dst) noexcept {
+  size_t i = 0;
+  // NOLINTBEGIN(cppcoreguidelines-pro-*)
+#if defined(__F16C__) && defined(__AVX__)
+  if constexpr (std::is_same_v<Storage, float16>) {
+    for (; i + 8UZ <= n; i += 8UZ) {
+      const __m128i h = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+      _mm256_storeu_ps(dst + i, _mm256_cvtph_ps(h));
+    }
+  }
+#endif  // __F16C__ && __AVX__
+  for (; i < n; ++i) {
+    dst[i] = to_float(src[i]);
+  }
+  // NOLINTEND(cppcoreguidelines-pro-*)
+}
+
+template <detail::ReducedPrecision Storage>
+void convert_n(const float* src, size_t n, Storage* dst) noexcept {
+  size_t i = 0;
+  // NOLINTBEGIN(cppcoreguidelines-pro-*)
+#if defined(__F16C__) && defined(__AVX__)
+  if constexpr (std::is_same_v<Storage, float16>) {
+    for (; i + 8UZ <= n; i += 8UZ) {
+      const __m128i h = _mm256_cvtps_ph(_mm256_loadu_ps(src + i), _MM_FROUND_TO_NEAREST_INT);
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), h);
+    }
+  }
+#endif  // __F16C__ && __AVX__
+  for (; i < n; ++i) {
+    dst[i] = from_float<Storage>(src[i]);
+  }
+  // NOLINTEND(cppcoreguidelines-pro-*)
+}
+
+// -------------------------------------------------------------------------------------------------
+// Reference to a reduced precision value that behaves like a float reference
+template <detail::ReducedPrecision Storage>
+class ReducedPrecisionRef {
+  Storage* m_ptr;
+
+ public:
+  constexpr explicit ReducedPrecisionRef(Storage* ptr) noexcept
+      : m_ptr(ptr) {}
+
+  constexpr operator float() const noexcept { return to_float(*m_ptr); }
+
+  constexpr auto operator=(float value) const noexcept -> const ReducedPrecisionRef& {
+    *m_ptr = from_float<Storage>(value);
+    return *this;
+  }
+  constexpr auto operator=(const ReducedPrecisionRef& other) const noexcept
+      -> const ReducedPrecisionRef& {
+    *m_ptr = *other.m_ptr;
+    return *this;
+  }
+  constexpr auto operator+=(float value) const noexcept -> const ReducedPrecisionRef& {
+    return *this = static_cast<float>(*this) + value;
+  }
+  constexpr auto operator-=(float value) const noexcept -> const ReducedPrecisionRef& {
+    return *this = static_cast<float>(*this) - value;
+  }
+  constexpr auto operator*=(float value) const noexcept -> const ReducedPrecisionRef& {
+    return *this = static_cast<float>(*this) * value;
+  }
+  constexpr auto operator/=(float value) const noexcept -> const ReducedPrecisionRef& {
+    return *this = static_cast<float>(*this) / value;
+  }
+};
+
+// -------------------------------------------------------------------------------------------------
+// Accessor that stores the elements as float16 or bfloat16 and converts on every load and store,
+// e.g. `MdArray<float, Extents, LayoutPolicy, fp16_accessor>` halves the memory traffic of a
+// bandwidth bound field. A const Storage gives read-only access.
+template <typename Storage>
+requires detail::ReducedPrecision<std::remove_const_t<Storage>>
+struct reduced_precision_accessor {
+  using offset_policy    = reduced_precision_accessor;
+  using storage_type     = Storage;
+  using element_type     = std::conditional_t<std::is_const_v<Storage>, const float, float>;
+  using reference        = std::conditional_t<std::is_const_v<Storage>,
+                                              float,
+                                              ReducedPrecisionRef<std::remove_const_t<Storage>>>;
+  using data_handle_type = Storage*;
+
+  constexpr reduced_precision_accessor() noexcept = default;
+
+  template <typename OtherStorage>
+  requires(std::is_convertible_v<OtherStorage (*)[], Storage (*)[]>)  // NOLINT
+  constexpr reduced_precision_accessor(
+      reduced_precision_accessor<OtherStorage> /*other*/) noexcept {}
+
+  [[nodiscard]] constexpr auto access(data_handle_type p, size_t i) const noexcept -> reference {
+    // NOLINTBEGIN(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    if constexpr (std::is_const_v<Storage>) {
+      return to_float(p[i]);
+    } else {
+      return reference(p + i);
+    }
+    // NOLINTEND(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+  }
+
+  [[nodiscard]] constexpr auto offset(data_handle_type p, size_t i) const noexcept
+      -> data_handle_type {
+    return p + i;  // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+  }
+};
+
+using fp16_accessor = reduced_precision_accessor<float16>;
+using bf16_accessor = reduced_precision_accessor<bfloat16>;
+
+namespace detail {
+
+template <typename AccessorPolicy>
+struct is_reduced_precision_accessor : std::false_type {};
+template <typename Storage>
+struct is_reduced_precision_accessor<reduced_precision_accessor<Storage>> : std::true_type {};
+
+}  // namespace detail
+
+}  // namespace Igor
+
+#endif  // IGOR_REDUCED_PRECISION_HPP_
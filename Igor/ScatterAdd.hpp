@@ -0,0 +1,195 @@
+#ifndef IGOR_SCATTER_ADD_HPP_
+#define IGOR_SCATTER_ADD_HPP_
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <mdspan>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <Igor/Logging.hpp>
+#include <Igor/MdAccessor.hpp>
+#include <Igor/MdArray.hpp>
+#include <Igor/Parallel.hpp>
+#include <Igor/ThreadPool.hpp>
+
+namespace Igor {
+
+// =================================================================================================
+// Concurrent scatter-add into an mdspan, e.g. the deposition of particles onto a grid, without
+// critical sections. `atomic_accessor` turns every `+=` into a relaxed atomic add, which is cheap
+// as long as threads rarely hit the same element. `PrivatizedReducer` gives every thread its own
+// copy of the target instead and adds the copies in parallel afterwards, which wins when the
+// updates are dense or highly contended but costs one copy of the target per thread.
+// =================================================================================================
+
+// -------------------------------------------------------------------------------------------------
+// Reference to an element that is only read and modified atomically with relaxed memory order. The
+// end of a parallel region synchronizes the results with the calling thread.
+template <typename ElementType>
+class AtomicRef {
+  std::atomic_ref<ElementType> m_ref;
+
+ public:
+  constexpr explicit AtomicRef(ElementType& element) noexcept
+      : m_ref(element) {}
+
+  operator ElementType() const noexcept { return m_ref.load(std::memory_order_relaxed); }
+
+  auto operator=(ElementType value) const noexcept -> ElementType {
+    m_ref.store(value, std::memory_order_relaxed);
+    return value;
+  }
+  auto operator=(const AtomicRef& other) const noexcept -> ElementType {
+    return *this = static_cast<ElementType>(other);
+  }
+
+  auto operator+=(ElementType value) const noexcept -> ElementType {
+    return m_ref.fetch_add(value, std::memory_order_relaxed) + value;
+  }
+  auto operator-=(ElementType value) const noexcept -> ElementType {
+    return m_ref.fetch_sub(value, std::memory_order_relaxed) - value;
+  }
+
+  auto fetch_add(ElementType value) const noexcept -> ElementType {
+    return m_ref.fetch_add(value, std::memory_order_relaxed);
+  }
+  auto exchange(ElementType value) const noexcept -> ElementType {
+    return m_ref.exchange(value, std::memory_order_relaxed);
+  }
+};
+
+// -------------------------------------------------------------------------------------------------
+// Accessor whose references are `AtomicRef`s, e.g. `MdArray<double, Extents, LayoutPolicy,
+// atomic_accessor<double>>` or `atomic_view(span)` for an existing mdspan.
+template <typename ElementType>
+struct atomic_accessor {
+  static_assert(!std::is_const_v<ElementType>, "Atomic access requires a mutable element type.");
+  static_assert(std::is_arithmetic_v<ElementType> && !std::is_same_v<ElementType, bool>,
+                "Atomic access requires an arithmetic element type.");
+  static_assert(std::atomic_ref<ElementType>::required_alignment == alignof(ElementType),
+                "Atomic access requires stricter alignment than the element type provides.");
+
+  using offset_policy    = atomic_accessor;
+  using element_type     = ElementType;
+  using reference        = AtomicRef<ElementType>;
+  using data_handle_type = ElementType*;
+
+  constexpr atomic_accessor() noexcept = default;
+  constexpr atomic_accessor(std::default_accessor<ElementType> /*other*/) noexcept {}  // NOLINT
+
+  [[nodiscard]] constexpr auto access(data_handle_type p, size_t i) const noexcept -> reference {
+    return reference(p[i]);  // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+  }
+
+  [[nodiscard]] constexpr auto offset(data_handle_type p, size_t i) const noexcept
+      -> data_handle_type {
+    return p + i;  // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+  }
+};
+
+// View of the elements of `span` through an `atomic_accessor`
+template <typename E, typename X, typename L, typename A>
+requires detail::has_plain_accessor<std::mdspan<E, X, L, A>>
+[[nodiscard]] constexpr auto atomic_view(const std::mdspan<E, X, L, A>& span) noexcept
+    -> std::mdspan<E, X, L, atomic_accessor<E>> {
+  return {span.data_handle(), span.mapping()};
+}
+
+// -------------------------------------------------------------------------------------------------
+// Privatized scatter-add into `target`: thread `t` adds into `local(t)` without synchronization,
+// `merge` adds all private copies into `target` in parallel and resets them to zero. Thread 0
+// writes to `target` directly, so only `n_threads - 1` copies are allocated. The copies are added
+// in thread order, i.e. the result is deterministic for a fixed number of threads.
+template <typename ElementType, typename Extents, typename LayoutPolicy = std::layout_right>
+class PrivatizedReducer {
+ public:
+  using view_type = std::mdspan<ElementType, Extents, LayoutPolicy>;
+
+ private:
+  using Copy = MdArray<ElementType, Extents, LayoutPolicy>;
+
+  view_type m_target;
+  std::vector<Copy> m_copies{};
+  size_t m_n_threads;
+
+ public:
+  explicit PrivatizedReducer(view_type target, size_t n_threads = num_threads())
+      : m_target(target),
+        m_n_threads(std::max(n_threads, 1UZ)) {
+    m_copies.reserve(m_n_threads - 1UZ);
+    for (size_t t = 1; t < m_n_threads; ++t) {
+      m_copies.push_back([&]<size_t... DIMS>(std::index_sequence<DIMS...>) {
+        return Copy(zero_init, target.extent(DIMS)...);
+      }(std::make_index_sequence<Extents::rank()>{}));
+      IGOR_ASSERT(m_copies.back().mapping() == target.mapping(),
+                  "Private copies must have the same mapping as the target.");
+    }
+  }
+
+  [[nodiscard]] constexpr auto n_threads() const noexcept -> size_t { return m_n_threads; }
+
+  // The elements thread `thread_id` adds into
+  [[nodiscard]] auto local(size_t thread_id) noexcept -> view_type {
+    IGOR_ASSERT(thread_id < m_n_threads,
+                "Thread id {} is out of range for {} threads.",
+                thread_id,
+                m_n_threads);
+    return thread_id == 0UZ ? m_target : view_type(m_copies[thread_id - 1UZ]);
+  }
+
+  // -----------------------------------------------------------------------------------------------
+  // Add the private copies into the target and reset them to zero, the buffer is split in
+  // contiguous blocks over the threads.
+  void merge() noexcept {
+    if (m_copies.empty()) { return; }
+    const auto n = static_cast<size_t>(m_target.mapping().required_span_size());
+    parallel_for(
+        0UZ,
+        m_n_threads,
+        [&](size_t thread_id) {
+          const auto [begin, end] = detail::static_chunk(0UZ, n, thread_id, m_n_threads);
+          // NOLINTBEGIN(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+          ElementType* target = m_target.data_handle();
+          for (auto& copy : m_copies) {
+            ElementType* local = copy.get_data();
+            for (size_t i = begin; i < end; ++i) {
+              target[i] += local[i];
+              local[i] = ElementType{0};
+            }
+          }
+          // NOLINTEND(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        },
+        m_n_threads);
+  }
+
+  // -----------------------------------------------------------------------------------------------
+  // Call `f(i, local)` for all i in [begin, end) split in contiguous blocks over the threads, where
+  // `local` is the view of the calling thread, then merge. `f` must not throw.
+  template <typename F>
+  void scatter(size_t begin, size_t end, F&& f) noexcept {
+    if (begin < end) {
+      auto run_chunk = [&](size_t thread_id) {
+        const auto [chunk_begin, chunk_end] =
+            detail::static_chunk(begin, end, thread_id, m_n_threads);
+        const auto view = local(thread_id);
+        for (size_t i = chunk_begin; i < chunk_end; ++i) {
+          f(i, view);
+        }
+      };
+      detail::ThreadPool::instance().run(m_n_threads, run_chunk);
+    }
+    merge();
+  }
+};
+
+template <typename E, typename X, typename L, typename A>
+PrivatizedReducer(const std::mdspan<E, X, L, A>&) -> PrivatizedReducer<E, X, L>;
+template <typename E, typename X, typename L, typename A>
+PrivatizedReducer(const std::mdspan<E, X, L, A>&, size_t) -> PrivatizedReducer<E, X, L>;
+
+}  // namespace Igor
+
+#endif  // IGOR_SCATTER_ADD_HPP_
@@ -0,0 +1,233 @@
+#ifndef IGOR_SHARED_MD_ARRAY_HPP_
+#define IGOR_SHARED_MD_ARRAY_HPP_
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mdspan>
+#include <optional>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+#include <Igor/Logging.hpp>
+#include <Igor/MdspanToNpy.hpp>
+#include <Igor/SharedMemory.hpp>
+
+namespace Igor {
+
+namespace detail {
+
+inline constexpr std::uint64_t SHARED_MD_ARRAY_MAGIC = 0x5941525241444D49;  // "IMDARRAY"
+inline constexpr size_t SHARED_MD_ARRAY_MAX_RANK     = 8UZ;
+// The elements start at a cache line boundary after the header
+inline constexpr size_t SHARED_MD_ARRAY_ALIGNMENT = 64UZ;
+
+// Description of the elements at the start of the segment, s.t. other processes can attach by name
+struct SharedMdArrayHeader {
+  std::uint64_t magic       = SHARED_MD_ARRAY_MAGIC;
+  std::uint64_t sequence    = 0;  // Seqlock counter, odd while a snapshot is written
+  std::uint64_t data_offset = 0;
+  std::uint64_t rank        = 0;
+  std::array<std::uint64_t, SHARED_MD_ARRAY_MAX_RANK> shape{};
+  std::array<char, 16> descr{};  // npy type string, e.g. "<f8"
+  std::uint8_t fortran_order = 0;
+};
+static_assert(std::is_trivially_copyable_v<SharedMdArrayHeader>);
+static_assert(std::atomic_ref<std::uint64_t>::required_alignment <= alignof(std::uint64_t));
+
+inline constexpr size_t SHARED_MD_ARRAY_DATA_OFFSET =
+    (sizeof(SharedMdArrayHeader) + SHARED_MD_ARRAY_ALIGNMENT - 1UZ) / SHARED_MD_ARRAY_ALIGNMENT *
+    SHARED_MD_ARRAY_ALIGNMENT;
+
+}  // namespace detail
+
+// -------------------------------------------------------------------------------------------------
+// mdspan over a named POSIX shared memory segment for zero-copy exchange of fields between
+// processes on a node. The creating process owns the segment and writes snapshots, other processes
+// attach by name and read them. Snapshots are guarded by a seqlock: the writer brackets every
+// snapshot with `begin_write` and `end_write`, readers copy the elements in `try_read` or
+// `read_snapshot`, which detect and retry reads that overlapped with a write. `generation()` counts
+// the completed snapshots, i.e. a reader polls it to learn that a new snapshot is ready.
+template <typename ElementType, typename Extents, typename LayoutPolicy = std::layout_right>
+class SharedMdArray : public std::mdspan<ElementType, Extents, LayoutPolicy> {
+  using Base = std::mdspan<ElementType, Extents, LayoutPolicy>;
+  static_assert(std::is_trivially_copyable_v<ElementType>,
+                "Element type must be trivially copyable.");
+  static_assert(alignof(ElementType) <= detail::SHARED_MD_ARRAY_ALIGNMENT,
+                "Element type is over-aligned.");
+  static_assert(std::is_same_v<LayoutPolicy, std::layout_right> ||
+                    std::is_same_v<LayoutPolicy, std::layout_left>,
+                "SharedMdArray requires layout_right or layout_left.");
+  static_assert(Extents::rank() > 0UZ && Extents::rank() <= detail::SHARED_MD_ARRAY_MAX_RANK,
+                "Rank is not supported.");
+
+  SharedMemory m_shm;
+
+  SharedMdArray(SharedMemory shm, const typename Base::mapping_type& mapping) noexcept
+      : Base(reinterpret_cast<ElementType*>(  // NOLINT
+                 static_cast<char*>(shm.data()) + header_of(shm).data_offset),
+             mapping),
+        m_shm(std::move(shm)) {}
+
+  [[nodiscard]] static auto header_of(SharedMemory& shm) noexcept -> detail::SharedMdArrayHeader& {
+    return *static_cast<detail::SharedMdArrayHeader*>(shm.data());
+  }
+  [[nodiscard]] auto header() const noexcept -> const detail::SharedMdArrayHeader& {
+    return *static_cast<const detail::SharedMdArrayHeader*>(m_shm.data());
+  }
+  [[nodiscard]] auto sequence() const noexcept -> std::atomic_ref<std::uint64_t> {
+    // The header lives in shared memory that is always mapped writable
+    return std::atomic_ref(const_cast<std::uint64_t&>(header().sequence));  // NOLINT
+  }
+
+  [[nodiscard]] static constexpr auto
+  data_bytes(const typename Base::mapping_type& mapping) noexcept -> size_t {
+    return static_cast<size_t>(mapping.required_span_size()) * sizeof(ElementType);
+  }
+
+ public:
+  // -----------------------------------------------------------------------------------------------
+  // Create the segment `name` (e.g. "/solver_velocity") for extents `n...` with zero-initialized
+  // elements, fails if the name exists already. A segment left behind by a crashed writer keeps its
+  // name until it is removed with `remove`.
+  template <typename... Sizes>
+  requires(std::is_convertible_v<std::remove_cvref_t<Sizes>, typename Extents::size_type> && ...)
+  [[nodiscard]] static auto create(std::string name, Sizes... n) noexcept
+      -> std::optional<SharedMdArray> {
+    static_assert(!std::is_const_v<ElementType>, "Only writers can create a SharedMdArray.");
+    const typename Base::mapping_type mapping(Extents(n...));
+    auto shm =
+        SharedMemory::create(name, detail::SHARED_MD_ARRAY_DATA_OFFSET + data_bytes(mapping));
+    if (!shm.has_value()) {
+      Igor::Warn("Could not create shared memory `{}`, it might be a stale segment.", name);
+      return std::nullopt;
+    }
+
+    detail::SharedMdArrayHeader header{};
+    header.data_offset   = detail::SHARED_MD_ARRAY_DATA_OFFSET;
+    header.rank          = Extents::rank();
+    header.fortran_order = std::is_same_v<LayoutPolicy, std::layout_left> ? 1U : 0U;
+    for (size_t r = 0; r < Extents::rank(); ++r) {
+      header.shape[r] = static_cast<std::uint64_t>(mapping.extents().extent(r));
+    }
+    const auto descr = detail::npy_descr<std::remove_const_t<ElementType>>();
+    std::copy_n(
+        descr.data(), std::min(descr.size(), header.descr.size() - 1UZ), header.descr.data());
+    std::construct_at(static_cast<detail::SharedMdArrayHeader*>(shm->data()), header);
+
+    return SharedMdArray{std::move(*shm), mapping};
+  }
+
+  // -----------------------------------------------------------------------------------------------
+  // Remove the segment `name`, e.g. after the writer crashed. Attached readers keep their mapping.
+  // Returns whether a segment was removed.
+  static auto remove(const std::string& name) noexcept -> bool {
+    return SharedMemory::remove(name);
+  }
+
+  // -----------------------------------------------------------------------------------------------
+  // Attach to the segment `name` created by another process. The element type, memory order and
+  // static extents must match the header, dynamic extents are taken from the header.
+  [[nodiscard]] static auto attach(std::string name) noexcept -> std::optional<SharedMdArray> {
+    auto shm = SharedMemory::open(name);
+    if (!shm.has_value()) {
+      Igor::Warn("Could not attach to shared memory `{}`.", name);
+      return std::nullopt;
+    }
+    if (shm->size() < detail::SHARED_MD_ARRAY_DATA_OFFSET ||
+        header_of(*shm).magic != detail::SHARED_MD_ARRAY_MAGIC) {
+      Igor::Warn("Shared memory `{}` does not contain a SharedMdArray.", shm->name());
+      return std::nullopt;
+    }
+
+    const auto& raw = header_of(*shm);
+    detail::NpyHeader header{
+        .descr         = std::string(raw.descr.data()),
+        .fortran_order = raw.fortran_order != 0U,
+        .shape         = {},
+        .data_offset   = static_cast<size_t>(raw.data_offset),
+    };
+    for (size_t r = 0; r < std::min<size_t>(raw.rank, detail::SHARED_MD_ARRAY_MAX_RANK); ++r) {
+      header.shape.push_back(static_cast<size_t>(raw.shape[r]));
+    }
+    if (!detail::npy_header_matches<ElementType, Extents, LayoutPolicy>(header, shm->name())) {
+      return std::nullopt;
+    }
+
+    std::array<typename Extents::index_type, Extents::rank()> extents{};
+    for (size_t r = 0; r < Extents::rank(); ++r) {
+      extents[r] = static_cast<typename Extents::index_type>(header.shape[r]);
+    }
+    const typename Base::mapping_type mapping{Extents(extents)};
+    if (header.data_offset % detail::SHARED_MD_ARRAY_ALIGNMENT != 0UZ ||
+        header.data_offset > shm->size() ||
+        data_bytes(mapping) > shm->size() - header.data_offset) {
+      Igor::Warn("Shared memory `{}` is too small for its extents.", shm->name());
+      return std::nullopt;
+    }
+    return SharedMdArray{std::move(*shm), mapping};
+  }
+
+  // -----------------------------------------------------------------------------------------------
+  // Number of completed snapshots
+  [[nodiscard]] auto generation() const noexcept -> std::uint64_t {
+    return sequence().load(std::memory_order_acquire) / 2U;
+  }
+
+  // Bracket the modification of the elements by the single writer
+  void begin_write() noexcept {
+    static_assert(!std::is_const_v<ElementType>, "Read-only SharedMdArrays cannot be written.");
+    const auto seq = sequence().load(std::memory_order_relaxed);
+    IGOR_ASSERT(seq % 2U == 0U, "Snapshot of `{}` is already being written.", m_shm.name());
+    sequence().store(seq + 1U, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+  }
+  void end_write() noexcept {
+    static_assert(!std::is_const_v<ElementType>, "Read-only SharedMdArrays cannot be written.");
+    const auto seq = sequence().load(std::memory_order_relaxed);
+    IGOR_ASSERT(seq % 2U == 1U, "No snapshot of `{}` is being written.", m_shm.name());
+    sequence().store(seq + 1U, std::memory_order_release);
+  }
+
+  // Write a snapshot with `f(view)`
+  template <typename F>
+  void write_snapshot(F&& f) {
+    begin_write();
+    f(static_cast<Base&>(*this));
+    end_write();
+  }
+
+  // -----------------------------------------------------------------------------------------------
+  // Call `f(view)` to copy the current snapshot, returns its generation if no write overlapped with
+  // the call, otherwise the copy is torn and must be discarded. `f` must only copy the elements.
+  template <typename F>
+  [[nodiscard]] auto try_read(F&& f) const -> std::optional<std::uint64_t> {
+    const auto begin = sequence().load(std::memory_order_acquire);
+    if (begin % 2U != 0U) { return std::nullopt; }
+    f(std::mdspan<const ElementType, Extents, LayoutPolicy>(*this));
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (sequence().load(std::memory_order_relaxed) != begin) { return std::nullopt; }
+    return begin / 2U;
+  }
+
+  // Retry `try_read` until a consistent snapshot was copied, returns its generation
+  template <typename F>
+  auto read_snapshot(F&& f) const -> std::uint64_t {
+    for (;;) {
+      if (const auto generation = try_read(f); generation.has_value()) { return *generation; }
+      std::this_thread::yield();
+    }
+  }
+
+  [[nodiscard]] constexpr auto shared_memory() const noexcept -> const SharedMemory& {
+    return m_shm;
+  }
+};
+
+}  // namespace Igor
+
+#endif  // IGOR_SHARED_MD_ARRAY_HPP_
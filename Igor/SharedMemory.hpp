@@ -0,0 +1,157 @@
+#ifndef IGOR_SHARED_MEMORY_HPP_
+#define IGOR_SHARED_MEMORY_HPP_
+
+#include <cerrno>
+#include <cstring>
+#include <optional>
+#include <string>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <Igor/Logging.hpp>
+
+namespace Igor {
+
+// -------------------------------------------------------------------------------------------------
+// RAII handle for a named POSIX shared memory segment (`shm_open` + `mmap`). The process that
+// created the segment is its owner and unlinks the name on destruction; attached processes only
+// unmap it.
+class SharedMemory {
+  std::string m_name{};
+  void* m_data    = nullptr;
+  size_t m_size   = 0;
+  bool m_is_owner = false;
+
+  constexpr SharedMemory(std::string name, void* data, size_t size, bool is_owner) noexcept
+      : m_name(std::move(name)),
+        m_data(data),
+        m_size(size),
+        m_is_owner(is_owner) {}
+
+  [[nodiscard]] static auto map(const std::string& name, int fd, size_t size) noexcept -> void* {
+    void* data = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (data == MAP_FAILED) {
+      Igor::Warn("Could not map shared memory `{}`: {}", name, std::strerror(errno));
+      return nullptr;
+    }
+    return data;
+  }
+
+ public:
+  // -----------------------------------------------------------------------------------------------
+  // Create a new segment of `size` zero-initialized bytes, fails if `name` already exists.
+  [[nodiscard]] static auto create(std::string name, size_t size) noexcept
+      -> std::optional<SharedMemory> {
+    const int fd = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, S_IRUSR | S_IWUSR);
+    if (fd == -1) {
+      if (errno != EEXIST) {
+        Igor::Warn("Could not create shared memory `{}`: {}", name, std::strerror(errno));
+      }
+      return std::nullopt;
+    }
+    if (ftruncate(fd, static_cast<off_t>(size)) == -1) {
+      Igor::Warn("Could not resize shared memory `{}` to {} bytes: {}",
+                 name,
+                 size,
+                 std::strerror(errno));
+      close(fd);
+      shm_unlink(name.c_str());
+      return std::nullopt;
+    }
+    void* data = map(name, fd, size);
+    close(fd);
+    if (data == nullptr) {
+      shm_unlink(name.c_str());
+      return std::nullopt;
+    }
+    return SharedMemory{std::move(name), data, size, true};
+  }
+
+  // -----------------------------------------------------------------------------------------------
+  // Attach to an existing segment, the size is taken from the segment itself.
+  [[nodiscard]] static auto open(std::string name) noexcept -> std::optional<SharedMemory> {
+    const int fd = shm_open(name.c_str(), O_RDWR, 0);
+    if (fd == -1) {
+      if (errno != ENOENT) {
+        Igor::Warn("Could not open shared memory `{}`: {}", name, std::strerror(errno));
+      }
+      return std::nullopt;
+    }
+    struct stat info{};
+    if (fstat(fd, &info) == -1 || info.st_size <= 0) {
+      close(fd);
+      return std::nullopt;
+    }
+    const auto size = static_cast<size_t>(info.st_size);
+    void* data      = map(name, fd, size);
+    close(fd);
+    if (data == nullptr) { return std::nullopt; }
+    return SharedMemory{std::move(name), data, size, false};
+  }
+
+  // -----------------------------------------------------------------------------------------------
+  // Create the segment if it does not exist yet, otherwise attach to it; `is_owner()` tells which
+  // of the two happened.
+  [[nodiscard]] static auto create_or_open(std::string name, size_t size) noexcept
+      -> std::optional<SharedMemory> {
+    if (auto shm = create(name, size); shm.has_value()) { return shm; }
+    return open(std::move(name));
+  }
+
+  // -----------------------------------------------------------------------------------------------
+  // Unlink the segment `name`, e.g. one left behind by a crashed owner. Processes that are attached
+  // keep their mapping. Returns whether a segment was removed.
+  static auto remove(const std::string& name) noexcept -> bool {
+    if (shm_unlink(name.c_str()) == -1) {
+      if (errno != ENOENT) {
+        Igor::Warn("Could not remove shared memory `{}`: {}", name, std::strerror(errno));
+      }
+      return false;
+    }
+    return true;
+  }
+
+  SharedMemory(const SharedMemory& other) noexcept                    = delete;
+  auto operator=(const SharedMemory& other) noexcept -> SharedMemory& = delete;
+  SharedMemory(SharedMemory&& other) noexcept
+      : m_name(std::move(other.m_name)),
+        m_data(std::exchange(other.m_data, nullptr)),
+        m_size(std::exchange(other.m_size, 0UZ)),
+        m_is_owner(std::exchange(other.m_is_owner, false)) {}
+  auto operator=(SharedMemory&& other) noexcept -> SharedMemory& {
+    if (this != &other) {
+      release();
+      m_name     = std::move(other.m_name);
+      m_data     = std::exchange(other.m_data, nullptr);
+      m_size     = std::exchange(other.m_size, 0UZ);
+      m_is_owner = std::exchange(other.m_is_owner, false);
+    }
+    return *this;
+  }
+  ~SharedMemory() noexcept { release(); }
+
+  void release() noexcept {
+    if (m_data != nullptr) {
+      munmap(m_data, m_size);
+      m_data = nullptr;
+    }
+    if (m_is_owner) {
+      shm_unlink(m_name.c_str());
+      m_is_owner = false;
+    }
+  }
+
+  [[nodiscard]] constexpr auto data() noexcept -> void* { return m_data; }
+  [[nodiscard]] constexpr auto data() const noexcept -> const void* { return m_data; }
+  [[nodiscard]] constexpr auto size() const noexcept -> size_t { return m_size; }
+  [[nodiscard]] constexpr auto name() const noexcept -> const std::string& { return m_name; }
+  [[nodiscard]] constexpr auto is_owner() const noexcept -> bool { return m_is_owner; }
+};
+
+}  // namespace Igor
+
+#endif  // IGOR_SHARED_MEMORY_HPP_
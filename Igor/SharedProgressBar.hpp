@@ -0,0 +1,220 @@
+#ifndef IGOR_SHARED_PROGRESS_BAR_HPP_
+#define IGOR_SHARED_PROGRESS_BAR_HPP_
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <thread>
+#include <utility>
+
+#include <signal.h>
+#include <unistd.h>
+
+#include <Igor/Logging.hpp>
+#include <Igor/ProgressBar.hpp>
+#include <Igor/SharedMemory.hpp>
+
+namespace Igor {
+
+// -------------------------------------------------------------------------------------------------
+// Progress bar shared by multiple processes on one node. Every process attaches to the named POSIX
+// shared memory segment `name` and owns one cache line sized slot in it. Updating the progress is a
+// single relaxed store into the own slot, only the leader (rank 0, the process that creates the
+// segment) renders the combined progress of all processes. A segment left behind by a crashed
+// leader is ignored by the other processes and replaced by the next leader.
+template <typename ProgressType = std::size_t>
+class SharedProgressBar {
+  static_assert(std::atomic_ref<ProgressType>::is_always_lock_free,
+                "ProgressType must be lock free to be shared between processes.");
+
+  static constexpr std::size_t CACHE_LINE_SIZE = 64UZ;
+  static constexpr std::uint64_t MAGIC         = 0x4947'4f52'5052'4247;  // "IGORPRBG"
+
+  struct alignas(CACHE_LINE_SIZE) Header {
+    std::uint64_t magic;
+    std::uint64_t num_slots;
+    std::uint64_t leader_pid;
+  };
+  struct alignas(CACHE_LINE_SIZE) Slot {
+    ProgressType progress;
+    ProgressType max_progress;
+  };
+
+  SharedMemory m_shm;
+  Header* m_header;
+  Slot* m_slots;
+  std::size_t m_num_processes;
+  std::size_t m_rank;
+  std::size_t m_length;
+  ProgressType m_max_progress;
+  ProgressType m_progress = 0;
+
+  SharedProgressBar(SharedMemory shm,
+                    std::size_t num_processes,
+                    std::size_t rank,
+                    ProgressType max_progress,
+                    std::size_t length) noexcept
+      : m_shm(std::move(shm)),
+        // NOLINTBEGIN(cppcoreguidelines-pro-type-reinterpret-cast)
+        m_header(reinterpret_cast<Header*>(m_shm.data())),
+        m_slots(reinterpret_cast<Slot*>(m_header + 1)),
+        // NOLINTEND(cppcoreguidelines-pro-type-reinterpret-cast)
+        m_num_processes(num_processes),
+        m_rank(rank),
+        m_length(length - 5UZ),
+        m_max_progress(max_progress) {}
+
+  [[nodiscard]] static constexpr auto segment_size(std::size_t num_processes) noexcept
+      -> std::size_t {
+    return sizeof(Header) + num_processes * sizeof(Slot);
+  }
+
+  // Whether the leader finished setting up `shm` and is still alive, i.e. the segment is not a
+  // leftover of a crashed run
+  [[nodiscard]] static auto is_published(SharedMemory& shm) noexcept -> bool {
+    if (shm.size() < sizeof(Header)) { return false; }
+    auto* header = static_cast<Header*>(shm.data());
+    if (std::atomic_ref<std::uint64_t>(header->magic).load(std::memory_order_acquire) != MAGIC) {
+      return false;
+    }
+    const auto pid = static_cast<pid_t>(
+        std::atomic_ref<std::uint64_t>(header->leader_pid).load(std::memory_order_relaxed));
+    return kill(pid, 0) == 0 || errno != ESRCH;
+  }
+
+ public:
+  // -----------------------------------------------------------------------------------------------
+  // Attach process `rank` of `num_processes` to the shared progress bar `name` (must start with a
+  // '/'). Rank 0 creates the segment and replaces a stale one, the other processes wait for at most
+  // `timeout` until it is set up.
+  [[nodiscard]] static auto
+  attach(const std::string& name,
+         std::size_t num_processes,
+         std::size_t rank,
+         ProgressType max_progress,
+         std::size_t length,
+         std::chrono::milliseconds timeout = std::chrono::seconds{10}) noexcept
+      -> std::optional<SharedProgressBar> {
+    IGOR_ASSERT(rank < num_processes,
+                "Rank {} is out of bounds for {} processes.",
+                rank,
+                num_processes);
+    const auto t_end             = std::chrono::steady_clock::now() + timeout;
+    constexpr auto poll_interval = std::chrono::milliseconds{1};
+
+    std::optional<SharedMemory> shm = std::nullopt;
+    if (rank == 0UZ) {
+      if (SharedMemory::remove(name)) {
+        Igor::Warn("Replaced stale shared progress bar `{}` of a previous run.", name);
+      }
+      shm = SharedMemory::create(name, segment_size(num_processes));
+      if (!shm.has_value()) {
+        Igor::Warn("Could not create shared progress bar `{}`.", name);
+        return std::nullopt;
+      }
+    } else {
+      // The segment might not exist yet, not be set up yet or be a leftover of a crashed leader
+      while (!(shm = SharedMemory::open(name)).has_value() || !is_published(*shm)) {
+        if (std::chrono::steady_clock::now() > t_end) {
+          Igor::Warn("Timed out waiting for the leader to set up shared progress bar `{}`.", name);
+          return std::nullopt;
+        }
+        std::this_thread::sleep_for(poll_interval);
+      }
+    }
+
+    SharedProgressBar bar(*std::move(shm), num_processes, rank, max_progress, length);
+    if (bar.is_leader()) {
+      // Start from empty slots and publish the segment only afterwards
+      for (std::size_t i = 0; i < num_processes; ++i) {
+        Slot& slot = bar.m_slots[i];  // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        std::atomic_ref<ProgressType>(slot.progress).store(0, std::memory_order_relaxed);
+        std::atomic_ref<ProgressType>(slot.max_progress).store(0, std::memory_order_relaxed);
+      }
+      std::atomic_ref<std::uint64_t>(bar.m_header->num_slots)
+          .store(num_processes, std::memory_order_relaxed);
+      std::atomic_ref<std::uint64_t>(bar.m_header->leader_pid)
+          .store(static_cast<std::uint64_t>(getpid()), std::memory_order_relaxed);
+      std::atomic_ref<std::uint64_t>(bar.m_header->magic).store(MAGIC, std::memory_order_release);
+    } else {
+      const auto num_slots =
+          std::atomic_ref<std::uint64_t>(bar.m_header->num_slots).load(std::memory_order_relaxed);
+      if (num_slots != num_processes || bar.m_shm.size() < segment_size(num_processes)) {
+        Igor::Warn("Shared progress bar `{}` was created for {} processes, not for {}.",
+                   name,
+                   num_slots,
+                   num_processes);
+        return std::nullopt;
+      }
+    }
+
+    Slot& slot = bar.m_slots[rank];  // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    std::atomic_ref<ProgressType>(slot.max_progress)
+        .store(max_progress, std::memory_order_relaxed);
+    std::atomic_ref<ProgressType>(slot.progress).store(0, std::memory_order_relaxed);
+    return bar;
+  }
+
+  // -----------------------------------------------------------------------------------------------
+  // Remove the segment of the shared progress bar `name`, e.g. before a restart after a crash.
+  // Returns whether a segment was removed.
+  static auto remove(const std::string& name) noexcept -> bool {
+    return SharedMemory::remove(name);
+  }
+
+  [[nodiscard]] constexpr auto is_leader() const noexcept -> bool { return m_shm.is_owner(); }
+  [[nodiscard]] constexpr auto rank() const noexcept -> std::size_t { return m_rank; }
+
+  void update(ProgressType delta = 1) noexcept {
+    m_progress = std::min(m_progress + delta, m_max_progress);
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    std::atomic_ref<ProgressType>(m_slots[m_rank].progress)
+        .store(m_progress, std::memory_order_relaxed);
+    if (is_leader()) { show(); }
+  }
+
+  // Sum of progress and sum of max. progress over all processes, slots of processes that did not
+  // attach yet count with the max. progress of this process.
+  [[nodiscard]] auto combined_progress() const noexcept -> std::pair<ProgressType, ProgressType> {
+    ProgressType progress     = 0;
+    ProgressType max_progress = 0;
+    for (std::size_t i = 0; i < m_num_processes; ++i) {
+      Slot& slot = m_slots[i];  // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+      const auto slot_max =
+          std::atomic_ref<ProgressType>(slot.max_progress).load(std::memory_order_relaxed);
+      progress += std::atomic_ref<ProgressType>(slot.progress).load(std::memory_order_relaxed);
+      max_progress += slot_max > 0 ? slot_max : m_max_progress;
+    }
+    return {progress, max_progress};
+  }
+
+  void show() const noexcept {
+    const auto [progress, max_progress] = combined_progress();
+    detail::show_progress(m_length, progress, max_progress);
+  }
+
+  // Render the combined progress until every process has finished or `timeout` passed, intended
+  // for the leader. Returns false on timeout, e.g. if a process died before finishing.
+  [[nodiscard]] auto
+  wait_for_all(std::chrono::milliseconds timeout,
+               std::chrono::milliseconds refresh = std::chrono::milliseconds{100}) const noexcept
+      -> bool {
+    const auto t_end = std::chrono::steady_clock::now() + timeout;
+    for (;;) {
+      const auto [progress, max_progress] = combined_progress();
+      detail::show_progress(m_length, progress, max_progress);
+      if (progress >= max_progress) { return true; }
+      if (std::chrono::steady_clock::now() > t_end) { return false; }
+      std::this_thread::sleep_for(std::min(refresh, timeout));
+    }
+  }
+};
+
+}  // namespace Igor
+
+#endif  // IGOR_SHARED_PROGRESS_BAR_HPP_
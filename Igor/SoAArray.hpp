@@ -0,0 +1,462 @@
+#ifndef IGOR_SOA_ARRAY_HPP_
+#define IGOR_SOA_ARRAY_HPP_
+
+#include <array>
+#include <cstddef>
+#include <mdspan>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include <Igor/Allocator.hpp>
+#include <Igor/MdAccessor.hpp>
+#include <Igor/MdArray.hpp>
+
+namespace Igor {
+
+// =================================================================================================
+// Containers for fields with multiple components per cell, e.g. velocity, pressure and temperature.
+// `SoAArray` stores one plane per component (struct of arrays), `AoSoAArray` interleaves blocks of
+// LANES elements of every component (array of structs of arrays) s.t. one block of a component
+// fills a SIMD register while all components of a cell stay close in memory.
+// =================================================================================================
+
+namespace detail {
+
+// Alignment of the buffer and of the component planes of a `SoAArray`
+inline constexpr size_t SOA_ALIGNMENT = 64UZ;
+
+template <typename... Components>
+concept SoAComponents =
+    sizeof...(Components) > 0UZ && ((std::is_trivially_default_constructible_v<Components> &&
+                                      std::is_trivially_destructible_v<Components>) &&
+                                     ...);
+
+template <typename Extents>
+[[nodiscard]] constexpr auto num_elements(const Extents& extents) noexcept -> size_t {
+  size_t n = 1;
+  for (size_t r = 0; r < Extents::rank(); ++r) {
+    n *= static_cast<size_t>(extents.extent(r));
+  }
+  return n;
+}
+
+using SoABuffer = MdArray<std::byte,
+                          std::dextents<size_t, 1>,
+                          std::layout_right,
+                          std::default_accessor<std::byte>,
+                          AlignedAllocator<std::byte, SOA_ALIGNMENT>>;
+
+template <typename Init>
+[[nodiscard]] auto make_soa_buffer(Init init, size_t bytes) -> SoABuffer {
+  if constexpr (std::is_same_v<Init, default_init_t>) {
+    return SoABuffer(bytes);
+  } else {
+    return SoABuffer(init, bytes);
+  }
+}
+
+}  // namespace detail
+
+// -------------------------------------------------------------------------------------------------
+// Reference to all components of one cell, `get<I>()` accesses a single component. Assigning a
+// tuple writes all components, converting to a tuple reads them.
+template <typename... Components>
+class CellRef {
+  std::tuple<Components*...> m_ptrs;
+
+ public:
+  constexpr explicit CellRef(Components*... ptrs) noexcept
+      : m_ptrs(ptrs...) {}
+
+  template <size_t I>
+  [[nodiscard]] constexpr auto get() const noexcept -> auto& {
+    return *std::get<I>(m_ptrs);
+  }
+
+  [[nodiscard]] constexpr auto load() const noexcept
+      -> std::tuple<std::remove_const_t<Components>...> {
+    return std::apply([](const auto*... ptrs) { return std::tuple{*ptrs...}; }, m_ptrs);
+  }
+  constexpr operator std::tuple<std::remove_const_t<Components>...>() const noexcept {
+    return load();
+  }
+
+  constexpr void store(const std::tuple<std::remove_const_t<Components>...>& values) const noexcept
+  requires(!std::is_const_v<Components> && ...)
+  {
+    [&]<size_t... I>(std::index_sequence<I...>) {
+      ((*std::get<I>(m_ptrs) = std::get<I>(values)), ...);
+    }(std::make_index_sequence<sizeof...(Components)>{});
+  }
+  constexpr auto
+  operator=(const std::tuple<std::remove_const_t<Components>...>& values) const noexcept
+      -> const CellRef&
+  requires(!std::is_const_v<Components> && ...)
+  {
+    store(values);
+    return *this;
+  }
+  // Copies the values of the cell `other` refers to, like assigning an element reference
+  constexpr auto operator=(const CellRef& other) const noexcept -> const CellRef&
+  requires(!std::is_const_v<Components> && ...)
+  {
+    store(other.load());
+    return *this;
+  }
+};
+
+// -------------------------------------------------------------------------------------------------
+// Struct of arrays: all components in one buffer aligned to `detail::SOA_ALIGNMENT` bytes, one
+// layout_right plane per component, each plane aligned as well.
+template <typename Extents, typename... Components>
+requires detail::SoAComponents<Components...>
+class SoAArray {
+ public:
+  using extents_type = Extents;
+  using index_type   = typename Extents::index_type;
+  using mapping_type = std::layout_right::mapping<Extents>;
+
+  static constexpr size_t num_components = sizeof...(Components);
+
+  template <size_t I>
+  using component_type = std::tuple_element_t<I, std::tuple<Components...>>;
+  template <size_t I>
+  using component_view = std::mdspan<component_type<I>,
+                                     Extents,
+                                     std::layout_right,
+                                     aligned_accessor<component_type<I>, detail::SOA_ALIGNMENT>>;
+  template <size_t I>
+  using const_component_view =
+      std::mdspan<const component_type<I>,
+                  Extents,
+                  std::layout_right,
+                  aligned_accessor<const component_type<I>, detail::SOA_ALIGNMENT>>;
+
+ private:
+  mapping_type m_mapping;
+  std::array<size_t, num_components> m_offsets{};
+  detail::SoABuffer m_buffer;
+
+  // Byte offsets of the planes, every plane starts aligned
+  [[nodiscard]] static constexpr auto plane_offsets(size_t n) noexcept
+      -> std::array<size_t, num_components + 1UZ> {
+    std::array<size_t, num_components + 1UZ> offsets{};
+    constexpr std::array<size_t, num_components> sizes{sizeof(Components)...};
+    for (size_t c = 0; c < num_components; ++c) {
+      offsets[c + 1UZ] = offsets[c] + detail::round_up(n * sizes[c], detail::SOA_ALIGNMENT);
+    }
+    return offsets;
+  }
+
+  template <typename Init>
+  SoAArray(Init init, const Extents& extents)
+      : m_mapping(extents),
+        m_buffer(detail::make_soa_buffer(
+            init, plane_offsets(detail::num_elements(extents))[num_components])) {
+    const auto offsets = plane_offsets(detail::num_elements(extents));
+    std::copy_n(offsets.begin(), num_components, m_offsets.begin());
+  }
+
+  // NOLINTBEGIN(cppcoreguidelines-pro-*)
+  template <size_t I>
+  [[nodiscard]] auto plane() noexcept -> component_type<I>* {
+    return reinterpret_cast<component_type<I>*>(m_buffer.get_data() + m_offsets[I]);
+  }
+  template <size_t I>
+  [[nodiscard]] auto plane() const noexcept -> const component_type<I>* {
+    return reinterpret_cast<const component_type<I>*>(m_buffer.get_data() + m_offsets[I]);
+  }
+  // NOLINTEND(cppcoreguidelines-pro-*)
+
+ public:
+  template <typename... Sizes>
+  requires(std::is_convertible_v<std::remove_cvref_t<Sizes>, index_type> && ...)
+  explicit SoAArray(Sizes... n)
+      : SoAArray(detail::default_init_t{}, Extents(n...)) {}
+
+  template <detail::MdArrayInit Init, typename... Sizes>
+  requires(std::is_convertible_v<std::remove_cvref_t<Sizes>, index_type> && ...)
+  explicit SoAArray(Init init, Sizes... n)
+      : SoAArray(init, Extents(n...)) {}
+
+  [[nodiscard]] constexpr auto extents() const noexcept -> const Extents& {
+    return m_mapping.extents();
+  }
+  [[nodiscard]] constexpr auto extent(size_t r) const noexcept -> index_type {
+    return extents().extent(r);
+  }
+  [[nodiscard]] constexpr auto size() const noexcept -> size_t {
+    return detail::num_elements(extents());
+  }
+
+  // Plane of component I
+  template <size_t I>
+  [[nodiscard]] auto component() noexcept -> component_view<I> {
+    return component_view<I>(plane<I>(), m_mapping);
+  }
+  template <size_t I>
+  [[nodiscard]] auto component() const noexcept -> const_component_view<I> {
+    return const_component_view<I>(plane<I>(), m_mapping);
+  }
+
+  // All components of the cell at `idx...`
+  template <typename... Indices>
+  requires(sizeof...(Indices) == Extents::rank() &&
+           (std::is_convertible_v<Indices, index_type> && ...))
+  [[nodiscard]] auto operator[](Indices... idx) noexcept -> CellRef<Components...> {
+    const auto offset = static_cast<size_t>(m_mapping(static_cast<index_type>(idx)...));
+    return [&]<size_t... I>(std::index_sequence<I...>) {
+      return CellRef<Components...>(plane<I>() + offset...);  // NOLINT
+    }(std::make_index_sequence<num_components>{});
+  }
+  template <typename... Indices>
+  requires(sizeof...(Indices) == Extents::rank() &&
+           (std::is_convertible_v<Indices, index_type> && ...))
+  [[nodiscard]] auto operator[](Indices... idx) const noexcept -> CellRef<const Components...> {
+    const auto offset = static_cast<size_t>(m_mapping(static_cast<index_type>(idx)...));
+    return [&]<size_t... I>(std::index_sequence<I...>) {
+      return CellRef<const Components...>(plane<I>() + offset...);  // NOLINT
+    }(std::make_index_sequence<num_components>{});
+  }
+};
+
+// -------------------------------------------------------------------------------------------------
+// Layout of one component of an `AoSoAArray`: the elements are numbered like layout_right and
+// stored in blocks of LANES contiguous elements, consecutive blocks are BLOCK_STRIDE elements
+// apart.
+template <size_t LANES, size_t BLOCK_STRIDE>
+struct layout_aosoa {
+  static_assert(LANES > 0UZ, "LANES must be positive.");
+  static_assert(BLOCK_STRIDE >= LANES, "Blocks must not overlap.");
+
+  template <typename Extents>
+  class mapping {
+   public:
+    using extents_type = Extents;
+    using index_type   = typename Extents::index_type;
+    using size_type    = typename Extents::size_type;
+    using rank_type    = typename Extents::rank_type;
+    using layout_type  = layout_aosoa;
+
+   private:
+    extents_type m_extents{};
+
+   public:
+    constexpr mapping() noexcept = default;
+    constexpr mapping(const extents_type& extents) noexcept
+        : m_extents(extents) {}
+
+    template <typename OtherExtents>
+    requires std::is_constructible_v<extents_type, OtherExtents>
+    constexpr explicit(!std::is_convertible_v<OtherExtents, extents_type>)
+        mapping(const mapping<OtherExtents>& other) noexcept
+        : mapping(extents_type(other.extents())) {}
+
+    [[nodiscard]] constexpr auto extents() const noexcept -> const extents_type& {
+      return m_extents;
+    }
+
+    [[nodiscard]] constexpr auto required_span_size() const noexcept -> index_type {
+      const auto n = static_cast<index_type>(detail::num_elements(m_extents));
+      if (n == 0) { return 0; }
+      const auto lanes = static_cast<index_type>(LANES);
+      return (n - 1) / lanes * static_cast<index_type>(BLOCK_STRIDE) + lanes;
+    }
+
+    template <typename... Indices>
+    requires(sizeof...(Indices) == Extents::rank() &&
+             (std::is_convertible_v<Indices, index_type> && ...))
+    [[nodiscard]] constexpr auto operator()(Indices... indices) const noexcept -> index_type {
+      const auto flat  = std::layout_right::mapping<Extents>(m_extents)(indices...);
+      const auto lanes = static_cast<index_type>(LANES);
+      return flat / lanes * static_cast<index_type>(BLOCK_STRIDE) + flat % lanes;
+    }
+
+    [[nodiscard]] static constexpr auto is_always_unique() noexcept -> bool { return true; }
+    [[nodiscard]] static constexpr auto is_always_exhaustive() noexcept -> bool {
+      return LANES == BLOCK_STRIDE && Extents::rank_dynamic() == 0 &&
+             detail::num_elements(Extents{}) % LANES == 0UZ;
+    }
+    [[nodiscard]] static constexpr auto is_always_strided() noexcept -> bool {
+      return LANES == BLOCK_STRIDE;
+    }
+
+    [[nodiscard]] static constexpr auto is_unique() noexcept -> bool { return true; }
+    [[nodiscard]] constexpr auto is_exhaustive() const noexcept -> bool {
+      return static_cast<size_t>(required_span_size()) == detail::num_elements(m_extents);
+    }
+    [[nodiscard]] static constexpr auto is_strided() noexcept -> bool {
+      return LANES == BLOCK_STRIDE;
+    }
+    [[nodiscard]] constexpr auto stride(rank_type r) const noexcept -> index_type
+    requires(LANES == BLOCK_STRIDE)
+    {
+      return std::layout_right::mapping<Extents>(m_extents).stride(r);
+    }
+
+    template <typename OtherExtents>
+    [[nodiscard]] friend constexpr auto operator==(const mapping& lhs,
+                                                   const mapping<OtherExtents>& rhs) noexcept
+        -> bool {
+      return lhs.extents() == rhs.extents();
+    }
+  };
+};
+
+// -------------------------------------------------------------------------------------------------
+// Array of structs of arrays: blocks of LANES cells, within a block all LANES values of the first
+// component, then of the second component and so on. With LANES equal to the SIMD width, e.g. 8
+// for AVX and float, `component_block<I>(b)` is one vector of component I. The block is only
+// guaranteed to be aligned for component I; it is aligned to a whole vector if the block size and
+// the offset of component I within a block are multiples of `LANES * sizeof(component_type<I>)`,
+// which is not the case e.g. for the double block of `AoSoAArray<X, 8, double, float>`.
+template <typename Extents, size_t LANES, typename... Components>
+requires detail::SoAComponents<Components...>
+class AoSoAArray {
+  static_assert(LANES > 0UZ, "LANES must be positive.");
+
+ public:
+  using extents_type = Extents;
+  using index_type   = typename Extents::index_type;
+  using mapping_type = std::layout_right::mapping<Extents>;
+
+  static constexpr size_t num_components = sizeof...(Components);
+  static constexpr size_t lanes          = LANES;
+
+  template <size_t I>
+  using component_type = std::tuple_element_t<I, std::tuple<Components...>>;
+
+ private:
+  static constexpr std::array<size_t, num_components> component_sizes{sizeof(Components)...};
+
+  // Size of a block and offsets of the components within a block in bytes
+  static constexpr size_t block_bytes     = LANES * (sizeof(Components) + ...);
+  static constexpr auto component_offsets = [] {
+    std::array<size_t, num_components> offsets{};
+    for (size_t c = 1; c < num_components; ++c) {
+      offsets[c] = offsets[c - 1UZ] + LANES * component_sizes[c - 1UZ];
+    }
+    return offsets;
+  }();
+
+  static_assert(
+      [] {
+        for (size_t c = 0; c < num_components; ++c) {
+          if (block_bytes % component_sizes[c] != 0UZ ||
+              component_offsets[c] % component_sizes[c] != 0UZ) {
+            return false;
+          }
+        }
+        return true;
+      }(),
+      "Blocks and the components within a block must be aligned for every component, choose a "
+      "multiple of the SIMD width for LANES.");
+
+ public:
+  template <size_t I>
+  using component_view = std::mdspan<component_type<I>,
+                                     Extents,
+                                     layout_aosoa<LANES, block_bytes / sizeof(component_type<I>)>>;
+  template <size_t I>
+  using const_component_view =
+      std::mdspan<const component_type<I>,
+                  Extents,
+                  layout_aosoa<LANES, block_bytes / sizeof(component_type<I>)>>;
+
+ private:
+  mapping_type m_mapping;
+  detail::SoABuffer m_buffer;
+
+  // NOLINTBEGIN(cppcoreguidelines-pro-*)
+  template <size_t I>
+  [[nodiscard]] auto block_ptr(size_t b) noexcept -> component_type<I>* {
+    return reinterpret_cast<component_type<I>*>(m_buffer.get_data() + b * block_bytes +
+                                                component_offsets[I]);
+  }
+  template <size_t I>
+  [[nodiscard]] auto block_ptr(size_t b) const noexcept -> const component_type<I>* {
+    return reinterpret_cast<const component_type<I>*>(m_buffer.get_data() + b * block_bytes +
+                                                      component_offsets[I]);
+  }
+  // NOLINTEND(cppcoreguidelines-pro-*)
+
+  template <typename Init>
+  AoSoAArray(Init init, const Extents& extents)
+      : m_mapping(extents),
+        m_buffer(detail::make_soa_buffer(
+            init, (detail::num_elements(extents) + LANES - 1UZ) / LANES * block_bytes)) {}
+
+ public:
+  template <typename... Sizes>
+  requires(std::is_convertible_v<std::remove_cvref_t<Sizes>, index_type> && ...)
+  explicit AoSoAArray(Sizes... n)
+      : AoSoAArray(detail::default_init_t{}, Extents(n...)) {}
+
+  template <detail::MdArrayInit Init, typename... Sizes>
+  requires(std::is_convertible_v<std::remove_cvref_t<Sizes>, index_type> && ...)
+  explicit AoSoAArray(Init init, Sizes... n)
+      : AoSoAArray(init, Extents(n...)) {}
+
+  [[nodiscard]] constexpr auto extents() const noexcept -> const Extents& {
+    return m_mapping.extents();
+  }
+  [[nodiscard]] constexpr auto extent(size_t r) const noexcept -> index_type {
+    return extents().extent(r);
+  }
+  [[nodiscard]] constexpr auto size() const noexcept -> size_t {
+    return detail::num_elements(extents());
+  }
+  // Number of blocks, the last block is padded if the size is not a multiple of LANES
+  [[nodiscard]] constexpr auto num_blocks() const noexcept -> size_t {
+    return (size() + LANES - 1UZ) / LANES;
+  }
+
+  // LANES contiguous values of component I of the cells with layout_right linear indices
+  // [b * LANES, (b + 1) * LANES)
+  template <size_t I>
+  [[nodiscard]] auto component_block(size_t b) noexcept -> component_type<I>* {
+    IGOR_ASSERT(b < num_blocks(), "Block {} is out of range for {} blocks.", b, num_blocks());
+    return block_ptr<I>(b);
+  }
+  template <size_t I>
+  [[nodiscard]] auto component_block(size_t b) const noexcept -> const component_type<I>* {
+    IGOR_ASSERT(b < num_blocks(), "Block {} is out of range for {} blocks.", b, num_blocks());
+    return block_ptr<I>(b);
+  }
+
+  // View of component I
+  template <size_t I>
+  [[nodiscard]] auto component() noexcept -> component_view<I> {
+    return component_view<I>(block_ptr<I>(0), m_mapping.extents());
+  }
+  template <size_t I>
+  [[nodiscard]] auto component() const noexcept -> const_component_view<I> {
+    return const_component_view<I>(block_ptr<I>(0), m_mapping.extents());
+  }
+
+  // All components of the cell at `idx...`
+  template <typename... Indices>
+  requires(sizeof...(Indices) == Extents::rank() &&
+           (std::is_convertible_v<Indices, index_type> && ...))
+  [[nodiscard]] auto operator[](Indices... idx) noexcept -> CellRef<Components...> {
+    const auto flat = static_cast<size_t>(m_mapping(static_cast<index_type>(idx)...));
+    return [&]<size_t... I>(std::index_sequence<I...>) {
+      return CellRef<Components...>(block_ptr<I>(flat / LANES) + flat % LANES...);  // NOLINT
+    }(std::make_index_sequence<num_components>{});
+  }
+  template <typename... Indices>
+  requires(sizeof...(Indices) == Extents::rank() &&
+           (std::is_convertible_v<Indices, index_type> && ...))
+  [[nodiscard]] auto operator[](Indices... idx) const noexcept -> CellRef<const Components...> {
+    const auto flat = static_cast<size_t>(m_mapping(static_cast<index_type>(idx)...));
+    return [&]<size_t... I>(std::index_sequence<I...>) {
+      // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+      return CellRef<const Components...>(block_ptr<I>(flat / LANES) + flat % LANES...);
+    }(std::make_index_sequence<num_components>{});
+  }
+};
+
+}  // namespace Igor
+
+#endif  // IGOR_SOA_ARRAY_HPP_
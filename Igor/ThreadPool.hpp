@@ -0,0 +1,180 @@
+#ifndef IGOR_THREAD_POOL_HPP_
+#define IGOR_THREAD_POOL_HPP_
+
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+#include <new>
+#include <system_error>
+#include <thread>
+
+#include <pthread.h>
+
+namespace Igor {
+
+namespace detail {
+
+// -------------------------------------------------------------------------------------------------
+// Fork-join pool of persistent worker threads, avoids creating threads for every parallel region.
+// Worker `i` always executes the task with thread id `i + 1`, the calling thread executes thread id
+// 0, s.t. repeated regions with the same decomposition touch the same data from the same threads.
+// The workers are detached and only counted, the child of a `fork` (which only contains the forking
+// thread) starts new workers with the next parallel region. `fork` must not be called from within
+// a parallel region.
+class ThreadPool {
+  struct Task {
+    void (*invoke)(void* context, size_t thread_id) noexcept = nullptr;
+    void* context                                            = nullptr;
+  };
+
+  std::mutex m_region_mutex;  // Serializes parallel regions started from different threads
+  std::mutex m_mutex;
+  std::condition_variable m_start_cv;
+  std::condition_variable m_done_cv;
+  Task m_task{};
+  size_t m_n_workers  = 0;
+  size_t m_generation = 0;
+  size_t m_n_threads  = 0;
+  size_t m_remaining  = 0;
+  bool m_stop         = false;
+
+  // Set in threads that execute a parallel region, nested regions run sequentially like OpenMP
+  // without nested parallelism
+  static auto in_region() noexcept -> bool& {
+    thread_local bool in_region = false;
+    return in_region;
+  }
+
+  // Wait for tasks of generations after `generation`
+  void worker_loop(size_t worker_id, size_t generation) noexcept {
+    in_region() = true;
+    for (;;) {
+      Task task{};
+      {
+        std::unique_lock lock(m_mutex);
+        m_start_cv.wait(lock, [&] { return m_stop || m_generation != generation; });
+        if (m_stop) {
+          m_n_workers -= 1UZ;
+          m_done_cv.notify_all();
+          return;
+        }
+        generation = m_generation;
+        if (worker_id + 1UZ >= m_n_threads) { continue; }
+        task = m_task;
+      }
+      task.invoke(task.context, worker_id + 1UZ);
+      {
+        std::lock_guard lock(m_mutex);
+        m_remaining -= 1UZ;
+        if (m_remaining == 0UZ) { m_done_cv.notify_all(); }
+      }
+    }
+  }
+
+  // Start workers until there are `n_workers`, must hold `m_mutex`. Returns false if a thread could
+  // not be created.
+  [[nodiscard]] auto start_workers(size_t n_workers) noexcept -> bool {
+    try {
+      while (m_n_workers < n_workers) {
+        std::thread(&ThreadPool::worker_loop, this, m_n_workers, m_generation).detach();
+        m_n_workers += 1UZ;
+      }
+    } catch (const std::system_error&) {
+      return false;
+    }
+    return true;
+  }
+
+  // Fork handlers: the forking thread holds both locks while forking s.t. no parallel region is
+  // running and the child inherits a consistent state. None of the workers exist in the child, but
+  // the condition variables still count them as waiters and are therefore reinitialized.
+  void lock_for_fork() noexcept {
+    m_region_mutex.lock();
+    m_mutex.lock();
+  }
+  void unlock_after_fork(bool is_child) noexcept {
+    if (is_child) {
+      new (&m_start_cv) std::condition_variable;
+      new (&m_done_cv) std::condition_variable;
+      m_n_workers = 0;
+    }
+    m_mutex.unlock();
+    m_region_mutex.unlock();
+  }
+
+ public:
+  ThreadPool() noexcept = default;
+  ThreadPool(const ThreadPool&)                    = delete;
+  ThreadPool(ThreadPool&&)                         = delete;
+  auto operator=(const ThreadPool&) -> ThreadPool& = delete;
+  auto operator=(ThreadPool&&) -> ThreadPool&      = delete;
+  ~ThreadPool() noexcept {
+    std::unique_lock lock(m_mutex);
+    m_stop = true;
+    m_start_cv.notify_all();
+    m_done_cv.wait(lock, [&] { return m_n_workers == 0UZ; });
+  }
+
+  [[nodiscard]] static auto instance() noexcept -> ThreadPool& {
+    static ThreadPool pool;
+    [[maybe_unused]] static const bool registered =
+        pthread_atfork([] { pool.lock_for_fork(); },
+                       [] { pool.unlock_after_fork(false); },
+                       [] { pool.unlock_after_fork(true); }) == 0;
+    return pool;
+  }
+
+  // Call `f(thread_id)` for all thread ids in [0, n_threads) concurrently, returns after all calls
+  // have finished. Runs sequentially if not enough threads can be created. `f` must not throw.
+  template <typename F>
+  void run(size_t n_threads, F& f) noexcept {
+    const auto run_sequentially = [&] {
+      for (size_t thread_id = 0; thread_id < n_threads; ++thread_id) {
+        f(thread_id);
+      }
+    };
+    if (n_threads <= 1UZ || in_region()) {
+      run_sequentially();
+      return;
+    }
+
+    std::lock_guard region_lock(m_region_mutex);
+    bool started = false;
+    {
+      std::lock_guard lock(m_mutex);
+      // Workers that were started before a failure wait for the next generation
+      started = start_workers(n_threads - 1UZ);
+      if (started) {
+        m_task = Task{
+            .invoke  = [](void* context, size_t thread_id) noexcept {
+              (*static_cast<F*>(context))(thread_id);
+            },
+            .context = static_cast<void*>(&f),
+        };
+        m_n_threads = n_threads;
+        m_remaining = n_threads - 1UZ;
+        m_generation += 1UZ;
+      }
+    }
+    if (!started) {
+      in_region() = true;
+      run_sequentially();
+      in_region() = false;
+      return;
+    }
+    m_start_cv.notify_all();
+
+    in_region() = true;
+    f(0UZ);
+    in_region() = false;
+
+    std::unique_lock lock(m_mutex);
+    m_done_cv.wait(lock, [&] { return m_remaining == 0UZ; });
+  }
+};
+
+}  // namespace detail
+
+}  // namespace Igor
+
+#endif  // IGOR_THREAD_POOL_HPP_
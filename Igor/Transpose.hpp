@@ -0,0 +1,331 @@
+#ifndef IGOR_TRANSPOSE_HPP_
+#define IGOR_TRANSPOSE_HPP_
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <mdspan>
+#include <type_traits>
+
+#if defined(__SSE2__)
+#include <immintrin.h>
+#endif  // __SSE2__
+
+#include <Igor/BulkMemory.hpp>
+#include <Igor/ForEachIndex.hpp>
+#include <Igor/Logging.hpp>
+#include <Igor/MdAccessor.hpp>
+#include <Igor/Parallel.hpp>
+
+namespace Igor {
+
+// =================================================================================================
+// Layout conversion and transposition of rank-2 and rank-3 mdspans. For layout_left and
+// layout_right data both reduce to either a plain copy or a reversal of the axes of the data in
+// memory. The reversal is cache-blocked and transposes small square tiles in SIMD registers for
+// float and double (SSE/AVX); large arrays are processed in parallel.
+// =================================================================================================
+
+namespace detail {
+
+// Side length of the square blocks in elements, two blocks of doubles fit into the L1 cache
+inline constexpr size_t TRANSPOSE_BLOCK = 32UZ;
+
+// -------------------------------------------------------------------------------------------------
+// In-register transposition of an N x N tile; N = 0 if there is no SIMD kernel for T
+// NOLINTBEGIN(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+template <typename T>
+struct TransposeKernel {
+  static constexpr size_t N = 0UZ;
+  static void apply(const T* /*src*/, size_t /*lds*/, T* /*dst*/, size_t /*ldd*/) noexcept {}
+};
+
+#if defined(__AVX__)
+template <>
+struct TransposeKernel<float> {
+  static constexpr size_t N = 8UZ;
+  static void apply(const float* src, size_t lds, float* dst, size_t ldd) noexcept {
+    const __m256 r0 = _mm256_loadu_ps(src + 0 * lds);
+    const __m256 r1 = _mm256_loadu_ps(src + 1 * lds);
+    const __m256 r2 = _mm256_loadu_ps(src + 2 * lds);
+    const __m256 r3 = _mm256_loadu_ps(src + 3 * lds);
+    const __m256 r4 = _mm256_loadu_ps(src + 4 * lds);
+    const __m256 r5 = _mm256_loadu_ps(src + 5 * lds);
+    const __m256 r6 = _mm256_loadu_ps(src + 6 * lds);
+    const __m256 r7 = _mm256_loadu_ps(src + 7 * lds);
+
+    const __m256 t0 = _mm256_unpacklo_ps(r0, r1);
+    const __m256 t1 = _mm256_unpackhi_ps(r0, r1);
+    const __m256 t2 = _mm256_unpacklo_ps(r2, r3);
+    const __m256 t3 = _mm256_unpackhi_ps(r2, r3);
+    const __m256 t4 = _mm256_unpacklo_ps(r4, r5);
+    const __m256 t5 = _mm256_unpackhi_ps(r4, r5);
+    const __m256 t6 = _mm256_unpacklo_ps(r6, r7);
+    const __m256 t7 = _mm256_unpackhi_ps(r6, r7);
+
+    const __m256 s0 = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(1, 0, 1, 0));
+    const __m256 s1 = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(3, 2, 3, 2));
+    const __m256 s2 = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(1, 0, 1, 0));
+    const __m256 s3 = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(3, 2, 3, 2));
+    const __m256 s4 = _mm256_shuffle_ps(t4, t6, _MM_SHUFFLE(1, 0, 1, 0));
+    const __m256 s5 = _mm256_shuffle_ps(t4, t6, _MM_SHUFFLE(3, 2, 3, 2));
+    const __m256 s6 = _mm256_shuffle_ps(t5, t7, _MM_SHUFFLE(1, 0, 1, 0));
+    const __m256 s7 = _mm256_shuffle_ps(t5, t7, _MM_SHUFFLE(3, 2, 3, 2));
+
+    _mm256_storeu_ps(dst + 0 * ldd, _mm256_permute2f128_ps(s0, s4, 0x20));
+    _mm256_storeu_ps(dst + 1 * ldd, _mm256_permute2f128_ps(s1, s5, 0x20));
+    _mm256_storeu_ps(dst + 2 * ldd, _mm256_permute2f128_ps(s2, s6, 0x20));
+    _mm256_storeu_ps(dst + 3 * ldd, _mm256_permute2f128_ps(s3, s7, 0x20));
+    _mm256_storeu_ps(dst + 4 * ldd, _mm256_permute2f128_ps(s0, s4, 0x31));
+    _mm256_storeu_ps(dst + 5 * ldd, _mm256_permute2f128_ps(s1, s5, 0x31));
+    _mm256_storeu_ps(dst + 6 * ldd, _mm256_permute2f128_ps(s2, s6, 0x31));
+    _mm256_storeu_ps(dst + 7 * ldd, _mm256_permute2f128_ps(s3, s7, 0x31));
+  }
+};
+
+template <>
+struct TransposeKernel<double> {
+  static constexpr size_t N = 4UZ;
+  static void apply(const double* src, size_t lds, double* dst, size_t ldd) noexcept {
+    const __m256d r0 = _mm256_loadu_pd(src + 0 * lds);
+    const __m256d r1 = _mm256_loadu_pd(src + 1 * lds);
+    const __m256d r2 = _mm256_loadu_pd(src + 2 * lds);
+    const __m256d r3 = _mm256_loadu_pd(src + 3 * lds);
+
+    const __m256d t0 = _mm256_unpacklo_pd(r0, r1);
+    const __m256d t1 = _mm256_unpackhi_pd(r0, r1);
+    const __m256d t2 = _mm256_unpacklo_pd(r2, r3);
+    const __m256d t3 = _mm256_unpackhi_pd(r2, r3);
+
+    _mm256_storeu_pd(dst + 0 * ldd, _mm256_permute2f128_pd(t0, t2, 0x20));
+    _mm256_storeu_pd(dst + 1 * ldd, _mm256_permute2f128_pd(t1, t3, 0x20));
+    _mm256_storeu_pd(dst + 2 * ldd, _mm256_permute2f128_pd(t0, t2, 0x31));
+    _mm256_storeu_pd(dst + 3 * ldd, _mm256_permute2f128_pd(t1, t3, 0x31));
+  }
+};
+#elif defined(__SSE2__)
+template <>
+struct TransposeKernel<float> {
+  static constexpr size_t N = 4UZ;
+  static void apply(const float* src, size_t lds, float* dst, size_t ldd) noexcept {
+    __m128 r0 = _mm_loadu_ps(src + 0 * lds);
+    __m128 r1 = _mm_loadu_ps(src + 1 * lds);
+    __m128 r2 = _mm_loadu_ps(src + 2 * lds);
+    __m128 r3 = _mm_loadu_ps(src + 3 * lds);
+    _MM_TRANSPOSE4_PS(r0, r1, r2, r3);  // NOLINT
+    _mm_storeu_ps(dst + 0 * ldd, r0);
+    _mm_storeu_ps(dst + 1 * ldd, r1);
+    _mm_storeu_ps(dst + 2 * ldd, r2);
+    _mm_storeu_ps(dst + 3 * ldd, r3);
+  }
+};
+
+template <>
+struct TransposeKernel<double> {
+  static constexpr size_t N = 2UZ;
+  static void apply(const double* src, size_t lds, double* dst, size_t ldd) noexcept {
+    const __m128d r0 = _mm_loadu_pd(src + 0 * lds);
+    const __m128d r1 = _mm_loadu_pd(src + 1 * lds);
+    _mm_storeu_pd(dst + 0 * ldd, _mm_unpacklo_pd(r0, r1));
+    _mm_storeu_pd(dst + 1 * ldd, _mm_unpackhi_pd(r0, r1));
+  }
+};
+#endif  // __AVX__
+
+// -------------------------------------------------------------------------------------------------
+// dst[c * ldd + r] = src[r * lds + c] for r in [row_begin, row_end) and c in [0, cols)
+template <typename T>
+void transpose_rows(const T* src,
+                    size_t row_begin,
+                    size_t row_end,
+                    size_t cols,
+                    size_t lds,
+                    T* dst,
+                    size_t ldd) noexcept {
+  using Kernel       = TransposeKernel<T>;
+  constexpr size_t B = TRANSPOSE_BLOCK;
+  static_assert(Kernel::N == 0UZ || B % Kernel::N == 0UZ);
+
+  for (size_t rb = row_begin; rb < row_end; rb += B) {
+    const size_t re = std::min(rb + B, row_end);
+    for (size_t cb = 0; cb < cols; cb += B) {
+      const size_t ce = std::min(cb + B, cols);
+      size_t r        = rb;
+      if constexpr (Kernel::N > 0UZ) {
+        constexpr size_t N = Kernel::N;
+        for (; r + N <= re; r += N) {
+          size_t c = cb;
+          for (; c + N <= ce; c += N) {
+            Kernel::apply(src + r * lds + c, lds, dst + c * ldd + r, ldd);
+          }
+          for (; c < ce; ++c) {
+            for (size_t rr = r; rr < r + N; ++rr) {
+              dst[c * ldd + rr] = src[rr * lds + c];
+            }
+          }
+        }
+      }
+      for (; r < re; ++r) {
+        for (size_t c = cb; c < ce; ++c) {
+          dst[c * ldd + r] = src[r * lds + c];
+        }
+      }
+    }
+  }
+}
+
+// -------------------------------------------------------------------------------------------------
+// Reverse the axes of the row-major array `src` with shape `dims` into `dst`, i.e.
+// dst[k][j][i] = src[i][j][k] for rank 3 and dst[j][i] = src[i][j] for rank 2
+template <typename T, size_t RANK>
+void reverse_axes(const T* src, const std::array<size_t, RANK>& dims, T* dst) noexcept {
+  static_assert(RANK == 2UZ || RANK == 3UZ, "Only rank 2 and rank 3 are supported.");
+  const size_t rows   = dims[0];
+  const size_t middle = RANK == 3UZ ? dims[1] : 1UZ;
+  const size_t cols   = dims[RANK - 1UZ];
+  const size_t size   = rows * middle * cols;
+
+  // A slab is one 2D transposition for a fixed middle index, split its rows in blocks for threads
+  const size_t row_blocks = (rows + TRANSPOSE_BLOCK - 1UZ) / TRANSPOSE_BLOCK;
+  const size_t work       = middle * row_blocks;
+  const size_t n_threads =
+      size * sizeof(T) < PARALLEL_THRESHOLD_BYTES ? 1UZ : std::min(num_threads(), work);
+
+  const auto run = [&](size_t begin, size_t end) {
+    for (size_t w = begin; w < end; ++w) {
+      const size_t j         = w / row_blocks;
+      const size_t row_begin = (w % row_blocks) * TRANSPOSE_BLOCK;
+      const size_t row_end   = std::min(row_begin + TRANSPOSE_BLOCK, rows);
+      transpose_rows(
+          src + j * cols, row_begin, row_end, cols, middle * cols, dst + j * rows, middle * rows);
+    }
+  };
+  if (n_threads <= 1UZ) {
+    run(0UZ, work);
+  } else {
+    parallel_for(
+        0UZ,
+        n_threads,
+        [&](size_t thread_id) {
+          const auto [begin, end] = static_chunk(0UZ, work, thread_id, n_threads);
+          run(begin, end);
+        },
+        n_threads);
+  }
+}
+// NOLINTEND(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+
+template <typename Mdspan>
+inline constexpr bool is_left = std::is_same_v<typename Mdspan::layout_type, std::layout_left>;
+
+template <typename Mdspan>
+inline constexpr bool is_left_or_right =
+    std::is_same_v<typename Mdspan::layout_type, std::layout_left> ||
+    std::is_same_v<typename Mdspan::layout_type, std::layout_right>;
+
+// Shape of the data of a layout_left/layout_right mdspan as a row-major array
+template <typename Mdspan>
+[[nodiscard]] constexpr auto memory_shape(const Mdspan& span) noexcept
+    -> std::array<size_t, Mdspan::rank()> {
+  constexpr size_t rank = Mdspan::rank();
+  std::array<size_t, rank> dims{};
+  for (size_t r = 0; r < rank; ++r) {
+    dims[r] = static_cast<size_t>(span.extent(is_left<Mdspan> ? rank - 1UZ - r : r));
+  }
+  return dims;
+}
+
+// Threads for an element-wise copy into `dst`
+template <typename T, typename Mdspan>
+[[nodiscard]] auto num_copy_threads(const Mdspan& dst) noexcept -> size_t {
+  return dst.size() * sizeof(T) < PARALLEL_THRESHOLD_BYTES ? 1UZ : num_threads();
+}
+
+// Copy `src` to `dst` s.t. the data in memory is identical (REVERSE = false) or the axes of the
+// data in memory are reversed; falls back to `generic()` if the mdspans are not plain
+// layout_left/layout_right mdspans of rank 2 or 3
+template <bool REVERSE, typename SrcSpan, typename DstSpan, typename Generic>
+void copy_or_reverse(const SrcSpan& src, const DstSpan& dst, Generic&& generic) {
+  using T                    = typename DstSpan::element_type;
+  using S                    = std::remove_const_t<typename SrcSpan::element_type>;
+  constexpr bool plain_spans = is_left_or_right<SrcSpan> && is_left_or_right<DstSpan> &&
+                               has_plain_accessor<SrcSpan> && has_plain_accessor<DstSpan> &&
+                               std::is_same_v<S, T>;
+  if constexpr (plain_spans && !REVERSE) {
+    parallel_copy_n(src.data_handle(), src.size(), dst.data_handle());
+  } else if constexpr (plain_spans && (SrcSpan::rank() == 2UZ || SrcSpan::rank() == 3UZ)) {
+    reverse_axes(src.data_handle(), memory_shape(src), dst.data_handle());
+  } else if constexpr (plain_spans && SrcSpan::rank() <= 1UZ) {
+    // Reversing zero or one axis is a copy
+    parallel_copy_n(src.data_handle(), src.size(), dst.data_handle());
+  } else {
+    generic();
+  }
+}
+
+}  // namespace detail
+
+// -------------------------------------------------------------------------------------------------
+// Copy `src` into the non-overlapping `dst` with identical extents, e.g. to convert Fortran-ordered
+// (layout_left) data to C-ordered (layout_right) data
+template <typename E1,
+          typename X1,
+          typename L1,
+          typename A1,
+          typename E2,
+          typename X2,
+          typename L2,
+          typename A2>
+requires std::is_same_v<std::remove_const_t<E1>, E2>
+void convert_layout(const std::mdspan<E1, X1, L1, A1>& src,
+                    const std::mdspan<E2, X2, L2, A2>& dst) {
+  using Src = std::mdspan<E1, X1, L1, A1>;
+  using Dst = std::mdspan<E2, X2, L2, A2>;
+  static_assert(X1::rank() == X2::rank(), "Source and destination must have the same rank.");
+  IGOR_ASSERT(src.extents() == dst.extents(), "Extents of source and destination do not match.");
+
+  detail::copy_or_reverse<detail::is_left<Src> != detail::is_left<Dst>>(src, dst, [&] {
+    parallel_for_index(
+        dst, [&](auto... idx) { dst[idx...] = src[idx...]; }, detail::num_copy_threads<E2>(dst));
+  });
+}
+
+// -------------------------------------------------------------------------------------------------
+// Reverse the axes of `src` into the non-overlapping `dst`, i.e. dst[j, i] = src[i, j] for rank 2
+// and dst[k, j, i] = src[i, j, k] for rank 3
+template <typename E1,
+          typename X1,
+          typename L1,
+          typename A1,
+          typename E2,
+          typename X2,
+          typename L2,
+          typename A2>
+requires std::is_same_v<std::remove_const_t<E1>, E2>
+void transpose(const std::mdspan<E1, X1, L1, A1>& src, const std::mdspan<E2, X2, L2, A2>& dst) {
+  using Src             = std::mdspan<E1, X1, L1, A1>;
+  using Dst             = std::mdspan<E2, X2, L2, A2>;
+  constexpr size_t rank = X1::rank();
+  static_assert(rank == X2::rank(), "Source and destination must have the same rank.");
+  static_assert(rank == 2UZ || rank == 3UZ, "Only rank 2 and rank 3 are supported.");
+  for (size_t r = 0; r < rank; ++r) {
+    IGOR_ASSERT(src.extent(r) == dst.extent(rank - 1UZ - r),
+                "Extents of the destination must be the reversed extents of the source.");
+  }
+
+  // Transposing into the opposite layout leaves the data in memory unchanged
+  detail::copy_or_reverse<detail::is_left<Src> == detail::is_left<Dst>>(src, dst, [&] {
+    parallel_for_index(src, [&](auto... idx) {
+      const std::array<typename X1::index_type, rank> i{idx...};
+      if constexpr (rank == 2UZ) {
+        dst[i[1], i[0]] = src[i[0], i[1]];
+      } else {
+        dst[i[2], i[1], i[0]] = src[i[0], i[1], i[2]];
+      }
+    }, detail::num_copy_threads<E2>(dst));
+  });
+}
+
+}  // namespace Igor
+
+#endif  // IGOR_TRANSPOSE_HPP_
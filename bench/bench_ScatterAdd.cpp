@@ -0,0 +1,95 @@
+#include <cstddef>
+#include <cstdint>
+#include <format>
+#include <mdspan>
+#include <utility>
+
+#include <Igor/Logging.hpp>
+#include <Igor/MdArray.hpp>
+#include <Igor/Parallel.hpp>
+#include <Igor/ScatterAdd.hpp>
+#include <Igor/Timer.hpp>
+
+// Deposition of particles onto an n x n grid with `atomic_accessor` and `PrivatizedReducer`:
+// - contended: many particles on a grid that fits into the cache, threads constantly hit the same
+//   cells
+// - sparse: few particles on a large grid, collisions are rare but every private copy has to be
+//   merged
+
+namespace {
+
+using Grid = Igor::MdArray<double, std::dextents<size_t, 2>>;
+
+constexpr size_t N_REPETITIONS = 5;
+
+// Pseudo-random cell of particle `p`, splitmix64
+[[nodiscard]] constexpr auto particle_cell(size_t p, size_t n) noexcept
+    -> std::pair<size_t, size_t> {
+  std::uint64_t z = static_cast<std::uint64_t>(p) + 0x9E3779B97F4A7C15ULL;
+  z               = (z ^ (z >> 30U)) * 0xBF58476D1CE4E5B9ULL;
+  z               = (z ^ (z >> 27U)) * 0x94D049BB133111EBULL;
+  z               = z ^ (z >> 31U);
+  return {static_cast<size_t>(z % n), static_cast<size_t>((z >> 32U) % n)};
+}
+
+[[nodiscard]] auto checksum(const Grid& grid) noexcept -> double {
+  double res = 0.0;
+  for (size_t i = 0; i < grid.size(); ++i) {
+    res += grid.get_data()[i];  // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+  }
+  return res;
+}
+
+void run_deposition(const char* name, size_t n, size_t n_particles) {
+  const size_t n_threads = Igor::num_threads();
+  Igor::Info("{}: {} particles on a {}x{} grid with {} threads, {} repetitions.",
+             name,
+             n_particles,
+             n,
+             n,
+             n_threads,
+             N_REPETITIONS);
+
+  Grid atomic_grid(Igor::zero_init, n, n);
+  {
+    const auto atomic = Igor::atomic_view(atomic_grid);
+    const Igor::ScopeTimer timer(std::format("{} atomic_accessor", name));
+    for (size_t rep = 0; rep < N_REPETITIONS; ++rep) {
+      Igor::parallel_for(
+          0UZ,
+          n_particles,
+          [&](size_t p) {
+            const auto [i, j] = particle_cell(p, n);
+            atomic[i, j] += 1.0;
+          },
+          n_threads);
+    }
+  }
+
+  Grid privatized_grid(Igor::zero_init, n, n);
+  {
+    Igor::PrivatizedReducer reducer(privatized_grid, n_threads);
+    {
+      const Igor::ScopeTimer timer(std::format("{} PrivatizedReducer", name));
+      for (size_t rep = 0; rep < N_REPETITIONS; ++rep) {
+        reducer.scatter(0UZ, n_particles, [n](size_t p, const auto& local) {
+          const auto [i, j] = particle_cell(p, n);
+          local[i, j] += 1.0;
+        });
+      }
+    }
+  }
+
+  Igor::Info("{}: checksums {} (atomic_accessor) and {} (PrivatizedReducer), expected {}.",
+             name,
+             checksum(atomic_grid),
+             checksum(privatized_grid),
+             static_cast<double>(N_REPETITIONS * n_particles));
+}
+
+}  // namespace
+
+auto main() -> int {
+  run_deposition("Contended", 64UZ, 1UZ << 24UZ);
+  run_deposition("Sparse", 2048UZ, 1UZ << 18UZ);
+}
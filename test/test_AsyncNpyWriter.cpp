@@ -0,0 +1,167 @@
+#include <filesystem>
+#include <future>
+#include <memory_resource>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <Igor/AsyncNpyWriter.hpp>
+#include <Igor/LayoutPadded.hpp>
+#include <Igor/MdArray.hpp>
+#include <Igor/NpyToMdArray.hpp>
+#include <Igor/ReducedPrecision.hpp>
+
+namespace {
+
+[[nodiscard]] auto snapshot_name(size_t i) -> std::string {
+  return (std::filesystem::temp_directory_path() /
+          ("igor_test_async_npy_" + std::to_string(i) + ".npy"))
+      .string();
+}
+
+}  // namespace
+
+TEST(TestAsyncNpyWriter, Snapshots) {
+  constexpr size_t n_snapshots = 6;
+  constexpr size_t m           = 31;
+  constexpr size_t n           = 57;
+  using Extents                = std::dextents<size_t, 2>;
+
+  Igor::MdArray<double, Extents> field(m, n);
+  {
+    Igor::AsyncNpyWriter writer(2);
+    EXPECT_EQ(writer.n_buffers(), 2);
+
+    std::vector<std::future<bool>> results;
+    for (size_t s = 0; s < n_snapshots; ++s) {
+      for (size_t i = 0; i < m; ++i) {
+        for (size_t j = 0; j < n; ++j) {
+          field[i, j] = static_cast<double>(s * m * n + i * n + j);
+        }
+      }
+      results.push_back(writer.write(field, snapshot_name(s)));
+      EXPECT_LE(writer.in_flight(), writer.n_buffers());
+      // The snapshot is a copy, modifying the field does not affect it
+      field[0, 0] = -1.0;
+    }
+    for (auto& result : results) {
+      EXPECT_TRUE(result.get());
+    }
+    writer.wait();
+    EXPECT_EQ(writer.in_flight(), 0);
+
+    // Write to a directory that does not exist
+    EXPECT_FALSE(writer.write(field, "/igor/does/not/exist.npy").get());
+  }
+
+  for (size_t s = 0; s < n_snapshots; ++s) {
+    const auto snapshot = Igor::npy_to_mdarray<double, Extents>(snapshot_name(s));
+    ASSERT_TRUE(snapshot.has_value());
+    for (size_t i = 0; i < m; ++i) {
+      for (size_t j = 0; j < n; ++j) {
+        ASSERT_EQ((snapshot->operator[](i, j)), static_cast<double>(s * m * n + i * n + j));
+      }
+    }
+    std::filesystem::remove(snapshot_name(s));
+  }
+}
+
+TEST(TestAsyncNpyWriter, LayoutsAndOwnership) {
+  constexpr size_t m = 13;
+  constexpr size_t n = 29;
+
+  Igor::MdArray<float, std::dextents<size_t, 2>, std::layout_left> left(m, n);
+  Igor::MdArray<float, std::dextents<size_t, 2>, Igor::layout_padded<8>> padded(m, n);
+  for (size_t i = 0; i < m; ++i) {
+    for (size_t j = 0; j < n; ++j) {
+      left[i, j]   = static_cast<float>(i) - static_cast<float>(j);
+      padded[i, j] = static_cast<float>(i * n + j);
+    }
+  }
+
+  {
+    Igor::AsyncNpyWriter writer(1);
+    auto left_result   = writer.write(left, snapshot_name(0));
+    auto padded_result = writer.write(padded, snapshot_name(1), 3);
+
+    Igor::MdArray<float, std::dextents<size_t, 2>> owned(m, n);
+    for (size_t i = 0; i < m; ++i) {
+      for (size_t j = 0; j < n; ++j) {
+        owned[i, j] = static_cast<float>(j * m + i);
+      }
+    }
+    auto owned_result = writer.write(std::move(owned), snapshot_name(2));
+
+    EXPECT_TRUE(left_result.get());
+    EXPECT_TRUE(padded_result.get());
+    EXPECT_TRUE(owned_result.get());
+  }
+
+  const auto left_read =
+      Igor::npy_to_mdarray<float, std::dextents<size_t, 2>, std::layout_left>(snapshot_name(0));
+  const auto padded_read = Igor::npy_to_mdarray<float, std::dextents<size_t, 2>>(snapshot_name(1));
+  const auto owned_read  = Igor::npy_to_mdarray<float, std::dextents<size_t, 2>>(snapshot_name(2));
+  ASSERT_TRUE(left_read.has_value());
+  ASSERT_TRUE(padded_read.has_value());
+  ASSERT_TRUE(owned_read.has_value());
+  for (size_t i = 0; i < m; ++i) {
+    for (size_t j = 0; j < n; ++j) {
+      ASSERT_EQ((left_read->operator[](i, j)), (left[i, j]));
+      ASSERT_EQ((padded_read->operator[](i, j)), (padded[i, j]));
+      ASSERT_EQ((owned_read->operator[](i, j)), static_cast<float>(j * m + i));
+    }
+  }
+  for (size_t s = 0; s < 3; ++s) {
+    std::filesystem::remove(snapshot_name(s));
+  }
+}
+
+TEST(TestAsyncNpyWriter, ReducedPrecisionAndAllocators) {
+  constexpr size_t m = 11;
+  constexpr size_t n = 23;
+  using Extents      = std::dextents<size_t, 2>;
+
+  Igor::ReducedPrecisionMdArray<Igor::float16, Extents> half(m, n);
+  Igor::MdArray<float, Extents, Igor::layout_padded<8>, Igor::fp16_accessor> padded_half(m, n);
+  Igor::pmr::MdArray<double, Extents> owned(
+      std::allocator_arg, std::pmr::new_delete_resource(), m, n);
+  for (size_t i = 0; i < m; ++i) {
+    for (size_t j = 0; j < n; ++j) {
+      half[i, j]        = static_cast<float>(i) + 0.5F * static_cast<float>(j);
+      padded_half[i, j] = static_cast<float>(j) - static_cast<float>(i);
+      owned[i, j]       = static_cast<double>(i * n + j);
+    }
+  }
+
+  {
+    Igor::AsyncNpyWriter writer(2);
+    auto half_result        = writer.write(half, snapshot_name(0));
+    auto padded_half_result = writer.write(padded_half, snapshot_name(1));
+    // Arrays with any allocator are moved into the writer instead of copied
+    auto owned_result = writer.write(std::move(owned), snapshot_name(2));
+    EXPECT_EQ(owned.get_data(), nullptr);  // NOLINT(bugprone-use-after-move)
+
+    EXPECT_TRUE(half_result.get());
+    EXPECT_TRUE(padded_half_result.get());
+    EXPECT_TRUE(owned_result.get());
+  }
+
+  // float16 elements are written as '<f2' like `mdspan_to_npy` does
+  const auto half_read        = Igor::npy_to_mdarray<Igor::float16, Extents>(snapshot_name(0));
+  const auto padded_half_read = Igor::npy_to_mdarray<Igor::float16, Extents>(snapshot_name(1));
+  const auto owned_read       = Igor::npy_to_mdarray<double, Extents>(snapshot_name(2));
+  ASSERT_TRUE(half_read.has_value());
+  ASSERT_TRUE(padded_half_read.has_value());
+  ASSERT_TRUE(owned_read.has_value());
+  for (size_t i = 0; i < m; ++i) {
+    for (size_t j = 0; j < n; ++j) {
+      ASSERT_EQ(Igor::to_float(half_read->operator[](i, j)), (half[i, j]));
+      ASSERT_EQ(Igor::to_float(padded_half_read->operator[](i, j)), (padded_half[i, j]));
+      ASSERT_EQ((owned_read->operator[](i, j)), static_cast<double>(i * n + j));
+    }
+  }
+  for (size_t s = 0; s < 3; ++s) {
+    std::filesystem::remove(snapshot_name(s));
+  }
+}
@@ -0,0 +1,103 @@
+#include <array>
+#include <cstddef>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <Igor/BitMdArray.hpp>
+
+TEST(TestBitMdArray, Access) {
+  constexpr size_t m = 7;
+  constexpr size_t n = 19;
+  Igor::BitMdArray<std::dextents<size_t, 2>> mask(m, n);
+  ASSERT_EQ(mask.num_words(), 3);
+  EXPECT_TRUE(mask.none());
+  EXPECT_EQ(mask.count(), 0);
+
+  for (size_t i = 0; i < m; ++i) {
+    for (size_t j = 0; j < n; ++j) {
+      mask[i, j] = (i + j) % 3 == 0;
+    }
+  }
+  for (size_t i = 0; i < m; ++i) {
+    for (size_t j = 0; j < n; ++j) {
+      EXPECT_EQ(static_cast<bool>(mask[i, j]), (i + j) % 3 == 0);
+    }
+  }
+  EXPECT_EQ(mask.count(), 45);
+  EXPECT_EQ(mask.count(2), 45);
+  EXPECT_TRUE(mask.any());
+  EXPECT_FALSE(mask.all());
+
+  mask[0, 0] ^= true;
+  mask[0, 1] |= true;
+  mask[0, 3] &= false;
+  mask[1, 1] = mask[0, 1];
+  EXPECT_FALSE(static_cast<bool>(mask[0, 0]));
+  EXPECT_TRUE(static_cast<bool>(mask[0, 1]));
+  EXPECT_FALSE(static_cast<bool>(mask[0, 3]));
+  EXPECT_TRUE(static_cast<bool>(mask[1, 1]));
+  EXPECT_EQ(mask.count(), 45);
+
+  // Read-only view
+  const std::mdspan<const bool,
+                    std::dextents<size_t, 2>,
+                    std::layout_right,
+                    Igor::bit_accessor<const bool>>
+      view = mask;
+  EXPECT_TRUE((view[1, 1]));
+  EXPECT_TRUE((view[6, 18]));
+
+  mask.fill(true);
+  EXPECT_TRUE(mask.all());
+  EXPECT_EQ(mask.count(), m * n);
+  mask.flip();
+  EXPECT_TRUE(mask.none());
+}
+
+TEST(TestBitMdArray, Bitwise) {
+  constexpr size_t n = 130;
+  Igor::BitMdArray<std::dextents<size_t, 1>> a(n);
+  Igor::BitMdArray<std::dextents<size_t, 1>> b(n);
+  for (size_t i = 0; i < n; ++i) {
+    a[i] = i % 2 == 0;
+    b[i] = i % 3 == 0;
+  }
+
+  const auto both   = a & b;
+  const auto either = a | b;
+  const auto one    = a ^ b;
+  EXPECT_EQ(both.count(), 22);
+  EXPECT_EQ(either.count(), 65 + 44 - 22);
+  EXPECT_EQ(one.count(), 65 + 44 - 2 * 22);
+  for (size_t i = 0; i < n; ++i) {
+    EXPECT_EQ(static_cast<bool>(both[i]), i % 6 == 0);
+  }
+
+  auto only_even = a.clone();
+  only_even.and_not(b);
+  EXPECT_EQ(only_even.count(), 65 - 22);
+  a |= b;
+  EXPECT_EQ(a.count(), either.count());
+  a ^= either;
+  EXPECT_TRUE(a.none());
+}
+
+TEST(TestBitMdArray, ForEachSet) {
+  Igor::BitMdArray<std::extents<size_t, 3, 4, 70>, std::layout_left> mask{};
+  const std::vector<std::array<size_t, 3>> set = {{0, 0, 0}, {2, 1, 0}, {1, 3, 21}, {2, 3, 69}};
+  for (const auto& [i, j, k] : set) {
+    mask[i, j, k] = true;
+  }
+
+  std::vector<std::array<size_t, 3>> visited;
+  mask.for_each_set([&](size_t i, size_t j, size_t k) { visited.push_back({i, j, k}); });
+  EXPECT_EQ(visited, set);
+
+  Igor::BitMdArray<std::dextents<size_t, 2>> right(3, 40);
+  right[2, 5]  = true;
+  right[0, 39] = true;
+  visited.clear();
+  right.for_each_set([&](size_t i, size_t j) { visited.push_back({i, j, 0}); });
+  EXPECT_EQ(visited, (std::vector<std::array<size_t, 3>>{{0, 39, 0}, {2, 5, 0}}));
+}
@@ -0,0 +1,81 @@
+#include <atomic>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <Igor/ForEachIndex.hpp>
+#include <Igor/MdArray.hpp>
+
+TEST(TestForEachIndex, LoopOrder) {
+  const std::dextents<size_t, 3> extents(2, 3, 4);
+
+  // The fastest varying index of the layout is the innermost loop, i.e. indices are visited in
+  // memory order
+  size_t count = 0;
+  Igor::for_each_index(extents, [&](size_t i, size_t j, size_t k) {
+    EXPECT_EQ(std::layout_right::mapping(extents)(i, j, k), count);
+    count += 1;
+  });
+  EXPECT_EQ(count, extents.extent(0) * extents.extent(1) * extents.extent(2));
+
+  count = 0;
+  Igor::for_each_index<std::layout_left>(extents, [&](size_t i, size_t j, size_t k) {
+    EXPECT_EQ(std::layout_left::mapping(extents)(i, j, k), count);
+    count += 1;
+  });
+  EXPECT_EQ(count, 24);
+
+  // Rank 0 has exactly one index
+  count = 0;
+  Igor::for_each_index(std::extents<size_t>{}, [&]() { count += 1; });
+  EXPECT_EQ(count, 1);
+}
+
+TEST(TestForEachIndex, Parallel) {
+  Igor::MdArray<std::atomic<int>, std::dextents<size_t, 3>, std::layout_left> visited(5, 7, 11);
+  for (size_t n_threads : {1UZ, 3UZ, 16UZ}) {
+    Igor::for_each_index(visited, [&](size_t i, size_t j, size_t k) { visited[i, j, k] = 0; });
+    Igor::parallel_for_index(
+        visited, [&](size_t i, size_t j, size_t k) { visited[i, j, k].fetch_add(1); }, n_threads);
+    Igor::for_each_index(visited,
+                         [&](size_t i, size_t j, size_t k) { EXPECT_EQ((visited[i, j, k]), 1); });
+  }
+}
+
+TEST(TestForEachIndex, Tiles) {
+  const std::dextents<size_t, 2> extents(10, 7);
+  std::vector<int> visited(extents.extent(0) * extents.extent(1), 0);
+  size_t num_tiles = 0;
+  Igor::for_each_tile(extents, {4UZ, 3UZ}, [&](const auto& tile) {
+    num_tiles += 1;
+    EXPECT_LE(tile.extent(0), 4);
+    EXPECT_LE(tile.extent(1), 3);
+    tile.for_each([&](size_t i, size_t j) { visited[i * extents.extent(1) + j] += 1; });
+  });
+  EXPECT_EQ(num_tiles, 3 * 3);
+  for (int v : visited) {
+    EXPECT_EQ(v, 1);
+  }
+
+  // Tiles spanning the inner dimension completely collapse to a linear range
+  std::vector<std::atomic<int>> linear(extents.extent(0) * extents.extent(1));
+  Igor::parallel_for_tile(
+      extents,
+      {3UZ, extents.extent(1)},
+      [&](const auto& tile) {
+        ASSERT_TRUE(tile.is_contiguous());
+        const auto [first, last] = tile.linear_range();
+        EXPECT_EQ(first, tile.begin(0) * extents.extent(1));
+        for (size_t i = first; i < last; ++i) {
+          linear[i].fetch_add(1);
+        }
+      },
+      3UZ);
+  for (const auto& v : linear) {
+    EXPECT_EQ(v.load(), 1);
+  }
+
+  Igor::for_each_tile<std::layout_left>(extents, {4UZ, 3UZ}, [&](const auto& tile) {
+    EXPECT_EQ(tile.is_contiguous(), tile.extent(0) == 10);
+  });
+}
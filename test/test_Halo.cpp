@@ -0,0 +1,134 @@
+#include <array>
+#include <cstddef>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <Igor/Halo.hpp>
+
+using Igor::HaloSide;
+
+TEST(TestHalo, Views) {
+  constexpr size_t g  = 2;
+  constexpr size_t nx = 5;
+  constexpr size_t ny = 4;
+  Igor::HaloMdArray<int, 2> a(g, nx, ny);
+  ASSERT_EQ(a.extent(0), nx + 2 * g);
+  ASSERT_EQ(a.extent(1), ny + 2 * g);
+  EXPECT_EQ(a.ghost_layers(), g);
+  EXPECT_EQ(a.interior_extent(0), nx);
+  EXPECT_EQ(a.interior_extent(1), ny);
+
+  for (size_t i = 0; i < a.extent(0); ++i) {
+    for (size_t j = 0; j < a.extent(1); ++j) {
+      a[i, j] = static_cast<int>(100 * i + j);
+    }
+  }
+
+  auto interior = a.interior();
+  ASSERT_EQ(interior.extent(0), nx);
+  ASSERT_EQ(interior.extent(1), ny);
+  EXPECT_EQ((interior[0, 0]), (a[g, g]));
+  EXPECT_EQ((interior[nx - 1, ny - 1]), (a[g + nx - 1, g + ny - 1]));
+  interior[1, 2] = -1;
+  EXPECT_EQ((a[g + 1, g + 2]), -1);
+
+  const auto low_x = a.ghost_face(0, HaloSide::LOW);
+  ASSERT_EQ(low_x.extent(0), g);
+  ASSERT_EQ(low_x.extent(1), ny);
+  EXPECT_EQ((low_x[0, 0]), (a[0, g]));
+  EXPECT_EQ((low_x[1, 3]), (a[1, g + 3]));
+
+  const auto high_y = a.boundary_face(1, HaloSide::HIGH);
+  ASSERT_EQ(high_y.extent(0), nx);
+  ASSERT_EQ(high_y.extent(1), g);
+  EXPECT_EQ((high_y[0, 0]), (a[g, ny]));
+  EXPECT_EQ((high_y[4, 1]), (a[g + 4, ny + 1]));
+
+  const auto& ca    = a;
+  const auto corner = ca.ghost({HaloSide::HIGH, HaloSide::LOW});
+  static_assert(std::is_const_v<decltype(corner)::element_type>);
+  ASSERT_EQ(corner.extent(0), g);
+  ASSERT_EQ(corner.extent(1), g);
+  EXPECT_EQ((corner[0, 0]), (a[g + nx, 0]));
+  EXPECT_EQ((corner[1, 1]), (a[g + nx + 1, 1]));
+}
+
+TEST(TestHalo, LayoutLeft) {
+  constexpr size_t g = 1;
+  Igor::HaloMdArray<double, 3, std::layout_left> a(g, 3, 4, 5);
+  for (size_t i = 0; i < a.extent(0); ++i) {
+    for (size_t j = 0; j < a.extent(1); ++j) {
+      for (size_t k = 0; k < a.extent(2); ++k) {
+        a[i, j, k] = static_cast<double>(100 * i + 10 * j + k);
+      }
+    }
+  }
+
+  const auto face = a.boundary_face(2, HaloSide::LOW);
+  ASSERT_EQ(face.extent(0), 3);
+  ASSERT_EQ(face.extent(1), 4);
+  ASSERT_EQ(face.extent(2), 1);
+  for (size_t i = 0; i < face.extent(0); ++i) {
+    for (size_t j = 0; j < face.extent(1); ++j) {
+      EXPECT_DOUBLE_EQ((face[i, j, 0]), (a[i + g, j + g, g]));
+    }
+  }
+
+  const auto edge = a.ghost({HaloSide::LOW, HaloSide::HIGH, HaloSide::CENTER});
+  ASSERT_EQ(edge.extent(2), 5);
+  EXPECT_DOUBLE_EQ((edge[0, 0, 2]), (a[0, 5, g + 2]));
+}
+
+TEST(TestHalo, PackUnpack) {
+  constexpr size_t g  = 2;
+  constexpr size_t nx = 6;
+  constexpr size_t ny = 7;
+  constexpr size_t nz = 3;
+  Igor::HaloMdArray<float, 3> a(g, Igor::zero_init, nx, ny, nz);
+  Igor::HaloMdArray<float, 3> b(g, Igor::zero_init, nx, ny, nz);
+  for (size_t i = 0; i < a.extent(0); ++i) {
+    for (size_t j = 0; j < a.extent(1); ++j) {
+      for (size_t k = 0; k < a.extent(2); ++k) {
+        a[i, j, k] = static_cast<float>(100 * i + 10 * j + k);
+      }
+    }
+  }
+
+  // Faces normal to every dimension, including the x-face whose rows are contiguous
+  for (size_t dim = 0; dim < 3; ++dim) {
+    for (const auto side : {HaloSide::LOW, HaloSide::HIGH}) {
+      const auto src = a.boundary_face(dim, side);
+      auto dst       = b.ghost_face(dim, side);
+      std::vector<float> buffer(src.size());
+
+      ASSERT_EQ(Igor::pack(src, buffer.data()), src.size());
+      ASSERT_EQ(Igor::unpack(static_cast<const float*>(buffer.data()), dst), dst.size());
+      for (size_t i = 0; i < src.extent(0); ++i) {
+        for (size_t j = 0; j < src.extent(1); ++j) {
+          for (size_t k = 0; k < src.extent(2); ++k) {
+            ASSERT_FLOAT_EQ((dst[i, j, k]), (src[i, j, k])) << "dim = " << dim;
+          }
+        }
+      }
+    }
+  }
+
+  // The interior is not touched
+  for (size_t i = 0; i < nx; ++i) {
+    EXPECT_FLOAT_EQ((b.interior()[i, 1, 1]), 0.0F);
+  }
+
+  // A full-width slab of layout_right is packed in memory order
+  Igor::HaloMdArray<int, 2> c(1, 2, 3);
+  for (size_t i = 0; i < c.size(); ++i) {
+    c.data_handle()[i] = static_cast<int>(i);  // NOLINT
+  }
+  const auto slab =
+      Igor::detail::sub_box(c, std::array<size_t, 2>{1, 0}, std::array<size_t, 2>{2, 5});
+  std::vector<int> buffer(slab.size());
+  ASSERT_EQ(Igor::pack(slab, buffer.data()), 10);
+  for (size_t i = 0; i < buffer.size(); ++i) {
+    EXPECT_EQ(buffer[i], static_cast<int>(i + 5));
+  }
+}
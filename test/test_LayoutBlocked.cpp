@@ -0,0 +1,84 @@
+#include <filesystem>
+#include <set>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <Igor/LayoutBlocked.hpp>
+#include <Igor/MdArray.hpp>
+#include <Igor/MdspanToNpy.hpp>
+#include <Igor/NpyToMdArray.hpp>
+
+TEST(TestLayoutBlocked, Mapping) {
+  using Layout = Igor::layout_blocked<4, 2, 3>;
+  const Layout::mapping<std::dextents<size_t, 3>> mapping(std::dextents<size_t, 3>(5, 4, 6));
+
+  // Padded to 8 x 4 x 6
+  EXPECT_EQ(mapping.required_span_size(), 8 * 4 * 6);
+  EXPECT_FALSE(mapping.is_exhaustive());
+
+  // Elements of a brick are contiguous
+  EXPECT_EQ(mapping(0, 0, 0), 0);
+  EXPECT_EQ(mapping(0, 0, 1), 1);
+  EXPECT_EQ(mapping(0, 1, 0), 3);
+  EXPECT_EQ(mapping(1, 0, 0), 6);
+  EXPECT_EQ(mapping(3, 1, 2), 23);
+  EXPECT_EQ(mapping(0, 0, 3), 24);
+
+  std::set<size_t> offsets;
+  Igor::for_each_index(mapping.extents(), [&](size_t i, size_t j, size_t k) {
+    const auto offset = mapping(i, j, k);
+    EXPECT_LT(offset, mapping.required_span_size());
+    offsets.insert(offset);
+  });
+  EXPECT_EQ(offsets.size(), 5 * 4 * 6);
+
+  static_assert(Layout::mapping<std::extents<size_t, 8, 4, 6>>::is_always_exhaustive());
+  static_assert(!Layout::mapping<std::extents<size_t, 8, 4, 7>>::is_always_exhaustive());
+}
+
+TEST(TestLayoutBlocked, MdArray) {
+  using Layout = Igor::layout_blocked<4, 4, 4>;
+  Igor::MdArray<double, std::dextents<size_t, 3>, Layout> a(9, 8, 5);
+  Igor::MdArray<double, std::dextents<size_t, 3>> ref(9, 8, 5);
+  Igor::for_each_index(ref, [&](size_t i, size_t j, size_t k) {
+    ref[i, j, k] = static_cast<double>(i * 100 + j * 10 + k);
+  });
+  a.copy_from(ref);
+  Igor::for_each_index(
+      a, [&](size_t i, size_t j, size_t k) { EXPECT_EQ((a[i, j, k]), (ref[i, j, k])); });
+
+  // Walk brick by brick, full bricks are contiguous in memory
+  std::vector<int> visited(a.size(), 0);
+  size_t full_bricks = 0;
+  Igor::for_each_brick(a, [&](const auto& brick) {
+    if (brick.size() == Layout::block_volume) {
+      full_bricks += 1;
+      const size_t first = a.mapping()(brick.begin(0), brick.begin(1), brick.begin(2));
+      EXPECT_EQ(first % Layout::block_volume, 0);
+    }
+    brick.for_each([&](size_t i, size_t j, size_t k) { visited[(i * 8 + j) * 5 + k] += 1; });
+  });
+  EXPECT_EQ(full_bricks, 2 * 2 * 1);
+  for (int v : visited) {
+    EXPECT_EQ(v, 1);
+  }
+}
+
+TEST(TestLayoutBlocked, Npy) {
+  using Layout = Igor::layout_blocked<2, 2>;
+  Igor::MdArray<float, std::dextents<size_t, 2>, Layout> a(3, 5);
+  Igor::for_each_index(a, [&](size_t i, size_t j) { a[i, j] = static_cast<float>(i * 5 + j); });
+
+  const auto filename = std::filesystem::temp_directory_path() / "igor_test_layout_blocked.npy";
+  ASSERT_TRUE(Igor::mdspan_to_npy(a, filename.string()));
+
+  // The data is written in C order
+  const auto b = Igor::npy_to_mdarray<float, std::dextents<size_t, 2>>(filename.string());
+  ASSERT_TRUE(b.has_value());
+  ASSERT_EQ(b->extents(), a.extents());
+  for (size_t i = 0; i < b->size(); ++i) {
+    EXPECT_EQ(b->get_data()[i], static_cast<float>(i));  // NOLINT
+  }
+  std::filesystem::remove(filename);
+}
@@ -0,0 +1,55 @@
+#include <cstdint>
+#include <filesystem>
+
+#include <gtest/gtest.h>
+
+#include <Igor/LayoutPadded.hpp>
+#include <Igor/MdArray.hpp>
+#include <Igor/MdspanToNpy.hpp>
+#include <Igor/NpyToMdArray.hpp>
+
+TEST(TestLayoutPadded, Mapping) {
+  using Layout = Igor::layout_padded<8>;
+
+  // Rows are padded to a multiple of 8, power of two strides get one more alignment unit
+  const Layout::mapping<std::dextents<size_t, 2>> small(std::dextents<size_t, 2>(3, 13));
+  EXPECT_EQ(small.stride(0), 16);
+  EXPECT_EQ(small.stride(1), 1);
+  EXPECT_EQ(small.required_span_size(), 2 * 16 + 13);
+  EXPECT_FALSE(small.is_exhaustive());
+
+  const Layout::mapping<std::dextents<size_t, 3>> grid(std::dextents<size_t, 3>(512, 512, 512));
+  EXPECT_EQ(grid.stride(2), 1);
+  EXPECT_EQ(grid.stride(1), 520);
+  EXPECT_EQ(grid.stride(0), 520 * 520);
+  EXPECT_EQ(grid(1, 2, 3), 520 * 520 + 2 * 520 + 3);
+
+  // Without anti-aliasing padding and with an aligned row length it is layout_right
+  const Igor::layout_padded<4, false>::mapping<std::dextents<size_t, 2>> plain(
+      std::dextents<size_t, 2>(1024, 1024));
+  EXPECT_EQ(plain.stride(0), 1024);
+  EXPECT_TRUE(plain.is_exhaustive());
+}
+
+TEST(TestLayoutPadded, MdArray) {
+  using Layout = Igor::layout_padded<8>;
+  Igor::AlignedMdArray<double, std::dextents<size_t, 2>, 64, Layout> a(5, 11);
+  for (size_t i = 0; i < a.extent(0); ++i) {
+    // Rows of an aligned array stay aligned
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(&a[i, 0]) % 64, 0);  // NOLINT
+    for (size_t j = 0; j < a.extent(1); ++j) {
+      a[i, j] = static_cast<double>(i * a.extent(1) + j);
+    }
+  }
+
+  // The padding is skipped when writing
+  const auto filename = std::filesystem::temp_directory_path() / "igor_test_layout_padded.npy";
+  ASSERT_TRUE(Igor::mdspan_to_npy(a, filename.string()));
+  const auto b = Igor::npy_to_mdarray<double, std::dextents<size_t, 2>>(filename.string());
+  ASSERT_TRUE(b.has_value());
+  ASSERT_EQ(b->extents(), a.extents());
+  for (size_t i = 0; i < b->size(); ++i) {
+    EXPECT_EQ(b->get_data()[i], static_cast<double>(i));  // NOLINT
+  }
+  std::filesystem::remove(filename);
+}
@@ -0,0 +1,128 @@
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <Igor/MappedMdArray.hpp>
+#include <Igor/MdArray.hpp>
+#include <Igor/MdspanToNpy.hpp>
+
+TEST(TestMappedMdArray, NpyHeader) {
+  using namespace std::string_literals;
+  const auto v1 = "\x93NUMPY\x01\x00"s + "\x3e\x00"s +
+                  "{'descr': '<f4', 'fortran_order': True, 'shape': (3, 40, 5), }"s;
+  const auto header = Igor::detail::parse_npy_header(v1, "v1");
+  ASSERT_TRUE(header.has_value());
+  EXPECT_EQ(header->descr, "<f4");
+  EXPECT_TRUE(header->fortran_order);
+  EXPECT_EQ(header->shape, (std::vector<size_t>{3, 40, 5}));
+  EXPECT_EQ(header->data_offset, 10 + 0x3e);
+
+  // Version 2.0 with a four byte header length and a one-dimensional shape
+  const auto v2 = "\x93NUMPY\x02\x00"s + "\x39\x00\x00\x00"s +
+                  "{'descr': '<f8', 'fortran_order': False, 'shape': (7,), }"s;
+  const auto header_v2 = Igor::detail::parse_npy_header(v2, "v2");
+  ASSERT_TRUE(header_v2.has_value());
+  EXPECT_EQ(header_v2->descr, "<f8");
+  EXPECT_FALSE(header_v2->fortran_order);
+  EXPECT_EQ(header_v2->shape, (std::vector<size_t>{7}));
+  EXPECT_EQ(header_v2->data_offset, 12 + 0x39);
+
+  EXPECT_FALSE(Igor::detail::parse_npy_header("NUMPY\x01\x00"s, "invalid").has_value());
+  EXPECT_FALSE(Igor::detail::parse_npy_header(v1.substr(0, 40), "truncated").has_value());
+}
+
+TEST(TestMappedMdArray, Npy) {
+  constexpr size_t m = 37;
+  constexpr size_t n = 129;
+  Igor::MdArray<double, std::dextents<size_t, 2>> a(m, n);
+  for (size_t i = 0; i < m; ++i) {
+    for (size_t j = 0; j < n; ++j) {
+      a[i, j] = static_cast<double>(i * n + j) / 3.0;
+    }
+  }
+  const auto filename = std::filesystem::temp_directory_path() / "igor_test_mapped.npy";
+  ASSERT_TRUE(Igor::mdspan_to_npy(a, filename.string()));
+
+  {
+    auto mapped =
+        Igor::MappedMdArray<const double, std::dextents<size_t, 2>>::open_npy(filename.string());
+    ASSERT_TRUE(mapped.has_value());
+    ASSERT_EQ(mapped->extent(0), m);
+    ASSERT_EQ(mapped->extent(1), n);
+    EXPECT_TRUE(mapped->advise(Igor::AccessAdvice::SEQUENTIAL));
+    for (size_t i = 0; i < m; ++i) {
+      for (size_t j = 0; j < n; ++j) {
+        ASSERT_DOUBLE_EQ(((*mapped)[i, j]), (a[i, j]));
+      }
+    }
+  }
+
+  {
+    // Copy-on-write, modifications do not reach the file
+    auto mapped =
+        Igor::MappedMdArray<double, std::extents<size_t, m, std::dynamic_extent>>::open_npy(
+            filename.string());
+    ASSERT_TRUE(mapped.has_value());
+    (*mapped)[1, 2] = -1.0;
+    EXPECT_DOUBLE_EQ(((*mapped)[1, 2]), -1.0);
+    EXPECT_TRUE(mapped->advise(Igor::AccessAdvice::RANDOM));
+  }
+  {
+    auto mapped =
+        Igor::MappedMdArray<const double, std::dextents<size_t, 2>>::open_npy(filename.string());
+    ASSERT_TRUE(mapped.has_value());
+    EXPECT_DOUBLE_EQ(((*mapped)[1, 2]), (a[1, 2]));
+  }
+
+  // Mismatching element type, layout, rank and static extent
+  EXPECT_FALSE((Igor::MappedMdArray<const float, std::dextents<size_t, 2>>::open_npy(
+                    filename.string())
+                    .has_value()));
+  EXPECT_FALSE(
+      (Igor::MappedMdArray<const double, std::dextents<size_t, 2>, std::layout_left>::open_npy(
+           filename.string())
+           .has_value()));
+  EXPECT_FALSE((Igor::MappedMdArray<const double, std::dextents<size_t, 3>>::open_npy(
+                    filename.string())
+                    .has_value()));
+  EXPECT_FALSE((Igor::MappedMdArray<const double, std::extents<size_t, m + 1, n>>::open_npy(
+                    filename.string())
+                    .has_value()));
+
+  std::filesystem::remove(filename);
+}
+
+TEST(TestMappedMdArray, Raw) {
+  const auto filename = std::filesystem::temp_directory_path() / "igor_test_mapped.bin";
+  std::vector<std::int32_t> values(4 + 6 * 5);
+  for (size_t i = 0; i < values.size(); ++i) {
+    values[i] = static_cast<std::int32_t>(i);
+  }
+  {
+    std::ofstream out(filename, std::ios::binary);
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+    out.write(reinterpret_cast<const char*>(values.data()),
+              static_cast<std::streamsize>(values.size() * sizeof(std::int32_t)));
+  }
+
+  // Skip a header of four elements and map the rest in Fortran order
+  using Mapped =
+      Igor::MappedMdArray<const std::int32_t, std::dextents<size_t, 2>, std::layout_left>;
+  const auto mapped = Mapped::open(filename.string(), std::dextents<size_t, 2>(6, 5), 16);
+  ASSERT_TRUE(mapped.has_value());
+  EXPECT_EQ(((*mapped)[0, 0]), 4);
+  EXPECT_EQ(((*mapped)[1, 0]), 5);
+  EXPECT_EQ(((*mapped)[0, 1]), 10);
+  EXPECT_EQ(((*mapped)[5, 4]), 33);
+
+  // Too small for the requested extents or misaligned
+  EXPECT_FALSE(Mapped::open(filename.string(), std::dextents<size_t, 2>(6, 6), 16).has_value());
+  EXPECT_FALSE(Mapped::open(filename.string(), std::dextents<size_t, 2>(2, 2), 2).has_value());
+  EXPECT_FALSE(Mapped::open("/nonexistent/igor.bin", std::dextents<size_t, 2>(1, 1)).has_value());
+
+  std::filesystem::remove(filename);
+}
@@ -1,5 +1,17 @@
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <cstdint>
+#include <memory_resource>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include <sys/mman.h>
+#include <unistd.h>
+
 #include <Igor/Logging.hpp>
 #include <Igor/MdArray.hpp>
 
@@ -79,3 +91,539 @@ TEST(TestMdArray, TwoDimensional) {
     EXPECT_EQ(md_arr.extent(1), n);
   }
 }
+
+TEST(TestMdArray, Move) {
+  constexpr size_t n = 64UZ;
+  Igor::MdArray<double, std::extents<size_t, std::dynamic_extent>> md_arr(n);
+  for (size_t i = 0; i < n; ++i) {
+    md_arr[i] = static_cast<double>(i);
+  }
+  const double* data = md_arr.get_data();
+
+  auto moved = std::move(md_arr);
+  EXPECT_EQ(moved.get_data(), data);
+  EXPECT_EQ(moved.data_handle(), data);
+  EXPECT_EQ(md_arr.get_data(), nullptr);  // NOLINT(bugprone-use-after-move)
+
+  Igor::MdArray<double, std::extents<size_t, std::dynamic_extent>> other(1UZ);
+  other = std::move(moved);
+  EXPECT_EQ(other.get_data(), data);
+  EXPECT_EQ(other.extent(0), n);
+  for (size_t i = 0; i < n; ++i) {
+    EXPECT_DOUBLE_EQ(other[i], static_cast<double>(i));
+  }
+}
+
+TEST(TestMdArray, NonTrivialElement) {
+  Igor::MdArray<std::string, std::extents<size_t, 3, 4>> md_arr(3, 4);
+  for (size_t i = 0; i < md_arr.extent(0); ++i) {
+    for (size_t j = 0; j < md_arr.extent(1); ++j) {
+      EXPECT_TRUE((md_arr[i, j].empty()));
+      md_arr[i, j] = std::string(32, static_cast<char>('a' + i + j));
+    }
+  }
+  EXPECT_EQ((md_arr[2, 3]), std::string(32, 'f'));
+}
+
+TEST(TestMdArray, InlineStorage) {
+  using Tensor = Igor::MdArray<double, std::extents<size_t, 3, 3>>;
+  static_assert(sizeof(Tensor) < 9 * sizeof(double) + 64UZ);
+  static_assert(std::is_copy_constructible_v<Tensor>);
+  static_assert(sizeof(Igor::MdArray<double, std::extents<size_t, 512>>) < 64UZ);
+
+  // Usable in constant expressions
+  static_assert([] {
+    Tensor identity(Igor::zero_init);
+    for (size_t i = 0; i < identity.extent(0); ++i) {
+      identity[i, i] = 1.0;
+    }
+    const Tensor copy = identity;
+    double trace      = 0.0;
+    for (size_t i = 0; i < copy.extent(0); ++i) {
+      trace += copy[i, i];
+    }
+    return trace + copy[0, 1];
+  }() == 3.0);
+  static_assert([] {
+    Tensor a(Igor::zero_init);
+    a.fill(2.0);
+    Igor::MdArray<double, std::extents<size_t, 3, 3>, std::layout_left> b(Igor::zero_init);
+    b.copy_from(a);
+    b[0, 1]           = 1.0;
+    const Tensor copy = a.clone();
+    return copy[2, 2] + b[0, 1] + b[1, 0];
+  }() == 5.0);
+
+  Tensor a(3, 3);
+  for (size_t i = 0; i < 3; ++i) {
+    for (size_t j = 0; j < 3; ++j) {
+      a[i, j] = static_cast<double>(3 * i + j);
+    }
+  }
+  Tensor b = a;
+  EXPECT_EQ(b.data_handle(), b.get_data());
+  EXPECT_NE(b.data_handle(), a.data_handle());
+  b[1, 1] = -1.0;
+  EXPECT_DOUBLE_EQ((a[1, 1]), 4.0);
+
+  a = b;
+  EXPECT_DOUBLE_EQ((a[1, 1]), -1.0);
+  EXPECT_DOUBLE_EQ((a[2, 2]), 8.0);
+
+  Igor::MdArray<double, std::extents<size_t, 3, 3>, std::layout_left> c(Igor::zero_init);
+  c.copy_from(a);
+  EXPECT_DOUBLE_EQ((c[2, 1]), 7.0);
+  EXPECT_DOUBLE_EQ(c.get_data()[5], 7.0);  // NOLINT
+
+  const Tensor moved = std::move(b);
+  EXPECT_EQ(moved.data_handle(), moved.get_data());
+  EXPECT_DOUBLE_EQ((moved[0, 2]), 2.0);
+
+  b.fill(0.5);
+  EXPECT_DOUBLE_EQ((b[2, 0]), 0.5);
+}
+
+TEST(TestMdArray, Aligned) {
+  {
+    Igor::AlignedMdArray<double, std::dextents<size_t, 3>> md_arr(7, 5, 3);
+    static_assert(decltype(md_arr)::accessor_type::byte_alignment == 64UZ);
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(md_arr.get_data()) % 64UZ, 0UZ);  // NOLINT
+    for (size_t i = 0; i < md_arr.size(); ++i) {
+      md_arr.get_data()[i] = static_cast<double>(i);  // NOLINT
+    }
+    EXPECT_DOUBLE_EQ((md_arr[1, 2, 0]), 21.0);
+  }
+
+  {
+    Igor::AlignedMdArray<float, std::extents<size_t, 3>, 128UZ> md_arr(3);
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(md_arr.get_data()) % 128UZ, 0UZ);  // NOLINT
+  }
+}
+
+TEST(TestMdArray, HugePages) {
+  // Larger than a huge page s.t. the mapping is used, explicit huge pages fall back to transparent
+  // huge pages if none are reserved
+  constexpr size_t n = 3UZ * 1024UZ * 1024UZ;
+  {
+    Igor::AlignedMdArray<float,
+                         std::dextents<size_t, 1>,
+                         64UZ,
+                         std::layout_right,
+                         Igor::PageKind::TRANSPARENT_HUGE>
+        md_arr(n);
+    constexpr size_t huge_page_size = 2UZ * 1024UZ * 1024UZ;
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(md_arr.get_data()) % huge_page_size, 0UZ);  // NOLINT
+    md_arr[0]     = 1.0F;
+    md_arr[n - 1] = 2.0F;
+    EXPECT_FLOAT_EQ(md_arr[0] + md_arr[n - 1], 3.0F);
+  }
+
+  {
+    Igor::AlignedMdArray<float,
+                         std::dextents<size_t, 1>,
+                         64UZ,
+                         std::layout_right,
+                         Igor::PageKind::EXPLICIT_HUGE>
+        md_arr(n);
+    md_arr[0]     = 1.0F;
+    md_arr[n - 1] = 2.0F;
+    EXPECT_FLOAT_EQ(md_arr[0] + md_arr[n - 1], 3.0F);
+  }
+}
+
+TEST(TestMdArray, InitPolicies) {
+  constexpr size_t m = 67UZ;
+  constexpr size_t n = 129UZ;
+
+  {
+    Igor::MdArray<double, std::dextents<size_t, 2>> md_arr(Igor::uninitialized, m, n);
+    for (size_t i = 0; i < m; ++i) {
+      for (size_t j = 0; j < n; ++j) {
+        md_arr[i, j] = static_cast<double>(i * n + j);
+      }
+    }
+    EXPECT_DOUBLE_EQ((md_arr[m - 1, n - 1]), static_cast<double>(m * n - 1));
+  }
+
+  {
+    Igor::MdArray<double, std::dextents<size_t, 2>> md_arr(Igor::zero_init, m, n);
+    for (size_t i = 0; i < md_arr.size(); ++i) {
+      EXPECT_DOUBLE_EQ(md_arr.get_data()[i], 0.0);  // NOLINT
+    }
+  }
+
+  {
+    // Over-aligned and large enough to be served by fresh pages, which are only backed by memory
+    // when touched
+    const auto page_size      = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    const auto resident_pages = [&](auto* data, size_t size) {
+      const auto address = reinterpret_cast<std::uintptr_t>(data);  // NOLINT
+      const auto first   = address - address % page_size;
+      const size_t bytes = address + size * sizeof(*data) - first;
+      std::vector<unsigned char> pages((bytes + page_size - 1UZ) / page_size);
+      EXPECT_EQ(mincore(reinterpret_cast<void*>(first), bytes, pages.data()), 0);  // NOLINT
+      return static_cast<size_t>(
+          std::ranges::count_if(pages, [](unsigned char page) { return (page & 1U) != 0U; }));
+    };
+
+    constexpr size_t size = 16UZ * 1024UZ * 1024UZ;
+    Igor::AlignedMdArray<float, std::dextents<size_t, 1>, 128UZ> md_arr(Igor::zero_init, size);
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(md_arr.get_data()) % 128UZ, 0UZ);  // NOLINT
+    EXPECT_LT(resident_pages(md_arr.get_data(), size), size * sizeof(float) / page_size / 4UZ);
+    EXPECT_FLOAT_EQ(md_arr[0], 0.0F);
+    EXPECT_FLOAT_EQ(md_arr[size / 2], 0.0F);
+    EXPECT_FLOAT_EQ(md_arr[size - 1], 0.0F);
+    EXPECT_GE(resident_pages(md_arr.get_data(), size), 1UZ);
+
+    // Default alignment of AlignedMdArray
+    Igor::AlignedMdArray<double, std::dextents<size_t, 2>> md_arr_64(
+        Igor::zero_init, 1024UZ, 1024UZ);
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(md_arr_64.get_data()) % 64UZ, 0UZ);  // NOLINT
+    EXPECT_LT(resident_pages(md_arr_64.get_data(), md_arr_64.size()),
+              md_arr_64.size() * sizeof(double) / page_size / 4UZ);
+    EXPECT_DOUBLE_EQ((md_arr_64[1023, 1023]), 0.0);
+  }
+
+  {
+    Igor::MdArray<std::string, std::dextents<size_t, 2>> md_arr(Igor::zero_init, 3, 2);
+    EXPECT_TRUE((md_arr[2, 1].empty()));
+  }
+
+  Igor::set_num_threads(4);
+  {
+    Igor::MdArray<double, std::dextents<size_t, 3>> md_arr(Igor::first_touch, m, n, 3);
+    for (size_t i = 0; i < md_arr.size(); ++i) {
+      EXPECT_DOUBLE_EQ(md_arr.get_data()[i], 0.0);  // NOLINT
+    }
+  }
+  {
+    Igor::MdArray<int, std::dextents<size_t, 2>, std::layout_left> md_arr(Igor::first_touch, m, 5);
+    for (size_t i = 0; i < md_arr.size(); ++i) {
+      EXPECT_EQ(md_arr.get_data()[i], 0);  // NOLINT
+    }
+  }
+  Igor::set_num_threads(0);
+}
+
+// Upstream resource that checks that blocks are returned with the alignment they were allocated
+class CheckingResource final : public std::pmr::memory_resource {
+  std::vector<std::pair<void*, size_t>> m_blocks{};
+
+ public:
+  size_t mismatches = 0;
+
+  [[nodiscard]] auto num_blocks() const noexcept -> size_t { return m_blocks.size(); }
+
+ private:
+  auto do_allocate(size_t bytes, size_t alignment) -> void* override {
+    void* data = std::pmr::new_delete_resource()->allocate(bytes, alignment);
+    m_blocks.emplace_back(data, alignment);
+    return data;
+  }
+
+  void do_deallocate(void* data, size_t bytes, size_t alignment) noexcept override {
+    const auto it = std::ranges::find(m_blocks, data, &std::pair<void*, size_t>::first);
+    if (it == m_blocks.end() || it->second != alignment) { mismatches += 1UZ; }
+    if (it != m_blocks.end()) { m_blocks.erase(it); }
+    std::pmr::new_delete_resource()->deallocate(data, bytes, alignment);
+  }
+
+  [[nodiscard]] auto do_is_equal(const std::pmr::memory_resource& other) const noexcept
+      -> bool override {
+    return this == &other;
+  }
+};
+
+// Upstream resource that returns blocks which are aligned as requested but never more, i.e. at an
+// odd multiple of the alignment
+class MinimallyAlignedResource final : public std::pmr::memory_resource {
+  static constexpr size_t PAGE = 4096UZ;
+
+  auto do_allocate(size_t bytes, size_t alignment) -> void* override {
+    auto* data = static_cast<std::byte*>(
+        std::pmr::new_delete_resource()->allocate(bytes + alignment, std::max(alignment, PAGE)));
+    return data + alignment;  // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+  }
+
+  void do_deallocate(void* data, size_t bytes, size_t alignment) noexcept override {
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    std::pmr::new_delete_resource()->deallocate(
+        static_cast<std::byte*>(data) - alignment, bytes + alignment, std::max(alignment, PAGE));
+  }
+
+  [[nodiscard]] auto do_is_equal(const std::pmr::memory_resource& other) const noexcept
+      -> bool override {
+    return this == &other;
+  }
+};
+
+TEST(TestMdArray, MemoryResource) {
+  using Array        = Igor::pmr::MdArray<double, std::dextents<size_t, 2>>;
+  constexpr size_t m = 32UZ;
+  constexpr size_t n = 48UZ;
+
+  {
+    Igor::ArenaResource arena(4UZ * m * n * sizeof(double));
+    const double* first_data = nullptr;
+    for (int step = 0; step < 3; ++step) {
+      Array a(std::allocator_arg, &arena, m, n);
+      Array b(std::allocator_arg, &arena, Igor::zero_init, m, n);
+      EXPECT_EQ(reinterpret_cast<std::uintptr_t>(a.get_data()) % alignof(double), 0UZ);  // NOLINT
+      EXPECT_NE(a.get_data(), b.get_data());
+      EXPECT_DOUBLE_EQ((b[m - 1, n - 1]), 0.0);
+      if (step == 0) { first_data = a.get_data(); }
+      // Memory is reused after resetting the arena
+      EXPECT_EQ(a.get_data(), first_data);
+      arena.reset();
+    }
+    EXPECT_EQ(arena.capacity(), 4UZ * m * n * sizeof(double));
+  }
+
+  {
+    // Over-aligned requests get chunks with a larger alignment, which must be passed back upstream
+    CheckingResource upstream;
+    {
+      Igor::ArenaResource arena(1024UZ, &upstream);
+      void* small = arena.allocate(512UZ, 8UZ);
+      void* large = arena.allocate(4096UZ, 256UZ);
+      EXPECT_EQ(reinterpret_cast<std::uintptr_t>(small) % 8UZ, 0UZ);    // NOLINT
+      EXPECT_EQ(reinterpret_cast<std::uintptr_t>(large) % 256UZ, 0UZ);  // NOLINT
+      EXPECT_EQ(upstream.num_blocks(), 2UZ);
+      arena.release();
+      EXPECT_EQ(upstream.num_blocks(), 0UZ);
+      std::ignore = arena.allocate(4096UZ, 512UZ);
+    }
+    EXPECT_EQ(upstream.num_blocks(), 0UZ);
+    EXPECT_EQ(upstream.mismatches, 0UZ);
+  }
+
+  {
+    // Requests with a larger alignment than the chunk are aligned by address, also after a reset
+    MinimallyAlignedResource upstream;
+    Igor::ArenaResource arena(4096UZ, &upstream);
+    for (int step = 0; step < 2; ++step) {
+      std::ignore = arena.allocate(8UZ, 8UZ);
+      for (size_t alignment = 16UZ; alignment <= 1024UZ; alignment *= 2UZ) {
+        void* data = arena.allocate(8UZ, alignment);
+        EXPECT_EQ(reinterpret_cast<std::uintptr_t>(data) % alignment, 0UZ)  // NOLINT
+            << "alignment = " << alignment;
+      }
+      EXPECT_EQ(arena.capacity(), 4096UZ);
+      arena.reset();
+    }
+  }
+
+  {
+    Igor::PoolResource pool;
+    const double* data = nullptr;
+    {
+      Array a(std::allocator_arg, &pool, m, n);
+      data = a.get_data();
+    }
+    EXPECT_EQ(pool.num_cached_blocks(), 1UZ);
+    {
+      // Slightly smaller arrays fall into the same size class
+      Array a(std::allocator_arg, &pool, m, n - 1);
+      EXPECT_EQ(a.get_data(), data);
+      EXPECT_EQ(pool.num_cached_blocks(), 0UZ);
+    }
+  }
+
+  {
+    Igor::PoolResource pool1;
+    Igor::PoolResource pool2;
+    Array a(std::allocator_arg, &pool1, m, n);
+    Array b(std::allocator_arg, &pool2, 2, 2);
+    a[1, 2]            = 42.0;
+    const double* data = a.get_data();
+
+    b = std::move(a);
+    EXPECT_EQ(b.get_data(), data);
+    EXPECT_EQ(b.get_allocator().resource(), &pool1);
+    EXPECT_DOUBLE_EQ((b[1, 2]), 42.0);
+    EXPECT_EQ(pool2.num_cached_blocks(), 1UZ);
+
+    Array c(std::move(b));
+    EXPECT_EQ(c.get_data(), data);
+    EXPECT_EQ(c.extent(0), m);
+    EXPECT_EQ(c.extent(1), n);
+  }
+}
+
+TEST(TestMdArray, CloneCopyFill) {
+  constexpr size_t m = 37UZ;
+  constexpr size_t n = 53UZ;
+  Igor::MdArray<double, std::extents<size_t, m, std::dynamic_extent>> md_arr(m, n);
+  for (size_t i = 0; i < m; ++i) {
+    for (size_t j = 0; j < n; ++j) {
+      md_arr[i, j] = static_cast<double>(i * n + j);
+    }
+  }
+
+  {
+    const auto clone = md_arr.clone();
+    EXPECT_NE(clone.get_data(), md_arr.get_data());
+    EXPECT_EQ(clone.extents(), md_arr.extents());
+    for (size_t i = 0; i < m; ++i) {
+      for (size_t j = 0; j < n; ++j) {
+        EXPECT_DOUBLE_EQ((clone[i, j]), (md_arr[i, j]));
+      }
+    }
+  }
+
+  {
+    // Layout conversion
+    Igor::MdArray<double, std::dextents<size_t, 2>, std::layout_left> left(m, n);
+    left.copy_from(md_arr);
+    for (size_t i = 0; i < m; ++i) {
+      for (size_t j = 0; j < n; ++j) {
+        EXPECT_DOUBLE_EQ((left[i, j]), (md_arr[i, j]));
+      }
+    }
+    EXPECT_DOUBLE_EQ(left.get_data()[1], (md_arr[1, 0]));  // NOLINT
+
+    Igor::MdArray<double, std::dextents<size_t, 2>> right(m, n);
+    right.fill(-1.0);
+    right.copy_from(std::mdspan<const double, std::dextents<size_t, 2>, std::layout_left>(
+        left.get_data(), m, n));
+    for (size_t i = 0; i < m; ++i) {
+      for (size_t j = 0; j < n; ++j) {
+        EXPECT_DOUBLE_EQ((right[i, j]), (md_arr[i, j]));
+      }
+    }
+  }
+
+  {
+    Igor::MdArray<std::string, std::dextents<size_t, 2>> strs(3, 4);
+    strs.fill("Igor");
+    const auto clone = strs.clone();
+    EXPECT_EQ((clone[2, 3]), "Igor");
+  }
+}
+
+TEST(TestMdArray, LargeCopyFill) {
+  // Large enough to use multiple threads and non-temporal stores
+  constexpr size_t n = (1UZ << 22UZ) + 3UZ;
+  Igor::set_num_threads(3);
+  for (float value : {0.0F, 1.5F, -3.25F}) {
+    Igor::MdArray<float, std::dextents<size_t, 1>> md_arr(n);
+    md_arr.fill(value);
+    for (size_t i = 0; i < n; ++i) {
+      ASSERT_FLOAT_EQ(md_arr[i], value);
+    }
+
+    md_arr[n / 2] = 42.0F;
+    const auto clone = md_arr.clone();
+    for (size_t i = 0; i < n; ++i) {
+      ASSERT_FLOAT_EQ(clone[i], i == n / 2 ? 42.0F : value);
+    }
+  }
+
+  {
+    constexpr size_t m = 2048UZ + 1UZ;
+    Igor::MdArray<double, std::dextents<size_t, 2>> right(m, m);
+    for (size_t i = 0; i < right.size(); ++i) {
+      right.get_data()[i] = static_cast<double>(i);  // NOLINT
+    }
+    Igor::MdArray<double, std::dextents<size_t, 2>, std::layout_left> left(Igor::uninitialized,
+                                                                           m,
+                                                                           m);
+    left.copy_from(right);
+    for (size_t i = 0; i < m; ++i) {
+      for (size_t j = 0; j < m; ++j) {
+        ASSERT_DOUBLE_EQ((left[i, j]), static_cast<double>(i * m + j));
+      }
+    }
+  }
+  Igor::set_num_threads(0);
+}
+
+namespace {
+
+// Copy assignment throws once `throw_on_copy` is set
+struct ThrowingCopy {
+  static inline bool throw_on_copy = false;
+  double value                     = 0.0;
+
+  ThrowingCopy() = default;
+  explicit ThrowingCopy(double v)
+      : value(v) {}
+  ThrowingCopy(const ThrowingCopy& other)
+      : value(other.value) {}
+  ThrowingCopy(ThrowingCopy&&) noexcept = default;
+  auto operator=(const ThrowingCopy& other) -> ThrowingCopy& {
+    if (throw_on_copy) { throw std::runtime_error("copy"); }
+    value = other.value;
+    return *this;
+  }
+  auto operator=(ThrowingCopy&&) noexcept -> ThrowingCopy& = default;
+  ~ThrowingCopy()                                          = default;
+};
+
+}  // namespace
+
+TEST(TestMdArray, ThrowingCopy) {
+  // Large enough to be split over threads if the copy could not throw, exceptions propagate
+  constexpr size_t n = (1UZ << 18UZ) + 3UZ;
+  Igor::set_num_threads(3);
+  Igor::MdArray<ThrowingCopy, std::dextents<size_t, 2>> a(n, 2);
+  Igor::MdArray<ThrowingCopy, std::dextents<size_t, 2>, std::layout_left> b(n, 2);
+
+  ThrowingCopy::throw_on_copy = false;
+  a.fill(ThrowingCopy(1.0));
+  b.copy_from(a);
+  EXPECT_EQ((b[n - 1, 1].value), 1.0);
+  EXPECT_EQ((a.clone()[n - 1, 1].value), 1.0);
+
+  ThrowingCopy::throw_on_copy = true;
+  EXPECT_THROW(std::ignore = a.clone(), std::runtime_error);
+  EXPECT_THROW(a.fill(ThrowingCopy{}), std::runtime_error);
+  EXPECT_THROW(b.copy_from(a), std::runtime_error);
+  ThrowingCopy::throw_on_copy = false;
+  Igor::set_num_threads(0);
+}
+
+TEST(TestMdArray, Reshape) {
+  constexpr size_t nx = 3;
+  constexpr size_t ny = 4;
+  constexpr size_t nz = 5;
+  Igor::MdArray<int, std::dextents<size_t, 2>> a(nx * ny, nz);
+  for (size_t ij = 0; ij < nx * ny; ++ij) {
+    for (size_t k = 0; k < nz; ++k) {
+      a[ij, k] = static_cast<int>(100 * ij + k);
+    }
+  }
+  const int* data = a.get_data();
+
+  // Non-owning views in several shapes
+  const auto view = Igor::reshape(a, nx, ny, nz);
+  static_assert(decltype(view)::rank() == 3);
+  EXPECT_EQ((view[2, 1, 3]), (a[2 * ny + 1, 3]));
+  const auto flat = Igor::reshape<std::extents<size_t, nx * ny * nz>>(a);
+  EXPECT_EQ(flat[7], (a[1, 2]));
+  const std::mdspan<const int, std::extents<size_t, nx * ny, nz>> static_span(data);
+  const auto static_view = Igor::reshape<std::extents<size_t, nx * ny * nz>>(static_span);
+  EXPECT_EQ(static_view[59], (a[11, 4]));
+
+  // The reshaped array takes ownership of the same buffer
+  auto b = std::move(a).reshape(nx, ny, nz);
+  static_assert(std::is_same_v<decltype(b), Igor::MdArray<int, std::dextents<size_t, 3>>>);
+  EXPECT_EQ(a.get_data(), nullptr);
+  EXPECT_EQ(b.get_data(), data);
+  EXPECT_EQ((b[2, 1, 3]), static_cast<int>(100 * (2 * ny + 1) + 3));
+
+  auto c = std::move(b).reshape<std::extents<size_t, nx, std::dynamic_extent>>(ny * nz);
+  EXPECT_EQ(c.get_data(), data);
+  EXPECT_EQ(c.extent(1), ny * nz);
+  EXPECT_EQ((c[1, 7]), (view[1, 1, 2]));
+
+  // layout_left reshapes in Fortran order
+  Igor::MdArray<double, std::dextents<size_t, 2>, std::layout_left> f(4, 6);
+  for (size_t i = 0; i < 4; ++i) {
+    for (size_t j = 0; j < 6; ++j) {
+      f[i, j] = static_cast<double>(10 * i + j);
+    }
+  }
+  auto g = std::move(f).reshape(2, 2, 6);
+  EXPECT_DOUBLE_EQ((g[1, 1, 5]), 35.0);
+}
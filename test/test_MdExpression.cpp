@@ -0,0 +1,98 @@
+#include <gtest/gtest.h>
+
+#include <Igor/MdExpression.hpp>
+
+TEST(TestMdExpression, Arithmetic) {
+  constexpr size_t m = 17UZ;
+  constexpr size_t n = 23UZ;
+  Igor::MdArray<double, std::extents<size_t, m, std::dynamic_extent>> a(m, n);
+  Igor::MdArray<double, std::dextents<size_t, 2>> b(m, n);
+  Igor::MdArray<double, std::dextents<size_t, 2>> c(m, n);
+  for (size_t i = 0; i < m; ++i) {
+    for (size_t j = 0; j < n; ++j) {
+      a[i, j] = static_cast<double>(i);
+      b[i, j] = static_cast<double>(j) + 1.0;
+    }
+  }
+
+  // Expressions are lazy and carry the merged extents
+  const auto e = a + 2.0 * b;
+  static_assert(decltype(e)::extents_type::static_extent(0) == m);
+  static_assert(decltype(e)::extents_type::static_extent(1) == std::dynamic_extent);
+  EXPECT_DOUBLE_EQ((e[2, 3]), 2.0 + 2.0 * 4.0);
+
+  c = a + 2.0 * b;
+  for (size_t i = 0; i < m; ++i) {
+    for (size_t j = 0; j < n; ++j) {
+      EXPECT_DOUBLE_EQ((c[i, j]), static_cast<double>(i) + 2.0 * (static_cast<double>(j) + 1.0));
+    }
+  }
+
+  c = (a - b) / b * 0.5 - (-a);
+  for (size_t i = 0; i < m; ++i) {
+    for (size_t j = 0; j < n; ++j) {
+      const auto ai = static_cast<double>(i);
+      const auto bj = static_cast<double>(j) + 1.0;
+      EXPECT_DOUBLE_EQ((c[i, j]), (ai - bj) / bj * 0.5 + ai);
+    }
+  }
+
+  // Aliasing of destination and operand is fine for elementwise expressions
+  c = c - c + 1.0;
+  for (size_t i = 0; i < c.size(); ++i) {
+    EXPECT_DOUBLE_EQ(c.get_data()[i], 1.0);  // NOLINT
+  }
+}
+
+TEST(TestMdExpression, MathFunctions) {
+  constexpr size_t n = 100UZ;
+  Igor::MdArray<double, std::dextents<size_t, 1>> a(n);
+  Igor::MdArray<double, std::dextents<size_t, 1>> b(n);
+  for (size_t i = 0; i < n; ++i) {
+    a[i] = static_cast<double>(i) - 50.0;
+  }
+
+  b = Igor::sqrt(Igor::abs(a)) + Igor::sqr(a);
+  for (size_t i = 0; i < n; ++i) {
+    EXPECT_DOUBLE_EQ(b[i], std::sqrt(std::abs(a[i])) + a[i] * a[i]);
+  }
+
+  // Scalar versions are unaffected
+  static_assert(Igor::sqr(3) == 9);
+  static_assert(Igor::abs(-2.5) == 2.5);
+}
+
+TEST(TestMdExpression, MixedLayouts) {
+  constexpr size_t m = 5UZ;
+  constexpr size_t n = 7UZ;
+  constexpr size_t k = 3UZ;
+  Igor::MdArray<int, std::dextents<size_t, 3>, std::layout_left> left(m, n, k);
+  Igor::MdArray<int, std::dextents<size_t, 3>> right(m, n, k);
+  Igor::MdArray<int, std::dextents<size_t, 3>> res(m, n, k);
+  for (size_t i = 0; i < m; ++i) {
+    for (size_t j = 0; j < n; ++j) {
+      for (size_t l = 0; l < k; ++l) {
+        left[i, j, l]  = static_cast<int>(i * 100 + j * 10 + l);
+        right[i, j, l] = 1;
+      }
+    }
+  }
+
+  // Plain std::mdspans are lifted with Igor::expr
+  std::mdspan<const int, std::dextents<size_t, 3>, std::layout_left> view(left.get_data(), m, n, k);
+  res = Igor::expr(view) * 2 + right;
+  for (size_t i = 0; i < m; ++i) {
+    for (size_t j = 0; j < n; ++j) {
+      for (size_t l = 0; l < k; ++l) {
+        EXPECT_EQ((res[i, j, l]), static_cast<int>(2 * (i * 100 + j * 10 + l) + 1));
+      }
+    }
+  }
+
+  // Evaluate into a plain mdspan
+  Igor::MdArray<int, std::dextents<size_t, 3>, std::layout_left> out(m, n, k);
+  const std::mdspan<int, std::dextents<size_t, 3>, std::layout_left> out_view(
+      out.get_data(), m, n, k);
+  Igor::evaluate(out_view, res - right);
+  EXPECT_EQ((out[4, 6, 2]), 2 * 462);
+}
@@ -0,0 +1,93 @@
+#include <algorithm>
+#include <array>
+#include <execution>
+#include <iterator>
+#include <numeric>
+#include <ranges>
+#include <type_traits>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <Igor/LayoutPadded.hpp>
+#include <Igor/MdArray.hpp>
+#include <Igor/MdIterator.hpp>
+
+TEST(TestMdIterator, Contiguous) {
+  using Array = Igor::MdArray<double, std::dextents<size_t, 3>>;
+  static_assert(std::contiguous_iterator<decltype(std::declval<Array&>().begin())>);
+  static_assert(std::ranges::contiguous_range<Array>);
+  static_assert(std::ranges::sized_range<const Array>);
+  static_assert(
+      std::is_const_v<std::remove_reference_t<decltype(*std::declval<const Array&>().begin())>>);
+
+  Array a(4, 5, 6);
+  Array b(4, 5, 6);
+  std::iota(a.begin(), a.end(), 0.0);
+  EXPECT_DOUBLE_EQ((a[1, 2, 3]), 1.0 * 30 + 2.0 * 6 + 3.0);
+
+  std::transform(std::execution::par_unseq, a.begin(), a.end(), b.begin(), [](double x) {
+    return 2.0 * x;
+  });
+  EXPECT_DOUBLE_EQ((b[3, 4, 5]), 2.0 * 119.0);
+  EXPECT_DOUBLE_EQ(std::reduce(std::execution::par, b.begin(), b.end()), 119.0 * 120.0);
+  EXPECT_EQ(std::ranges::count_if(a, [](double x) { return x >= 100.0; }), 20);
+
+  // Inline storage and plain mdspans
+  Igor::MdArray<int, std::extents<size_t, 3, 3>> small{};
+  std::ranges::fill(small, 7);
+  EXPECT_EQ(std::accumulate(small.begin(), small.end(), 0), 63);
+  const auto span = Igor::as_span(std::mdspan(a.get_data(), 4, 5, 6));
+  EXPECT_EQ(span.size(), 120);
+  EXPECT_DOUBLE_EQ(span.back(), 119.0);
+}
+
+TEST(TestMdIterator, Strided) {
+  Igor::MdArray<int, std::dextents<size_t, 2>, std::layout_left> a(Igor::zero_init, 4, 6);
+  // Every other column, layout_stride iterates the last index fastest
+  const std::layout_stride::mapping mapping(std::dextents<size_t, 2>(4, 3),
+                                            std::array<size_t, 2>{1, 8});
+  const std::mdspan<int, std::dextents<size_t, 2>, std::layout_stride> strided(a.get_data(),
+                                                                               mapping);
+  auto view = Igor::flat_view(strided);
+  static_assert(std::ranges::random_access_range<decltype(view)>);
+  static_assert(std::random_access_iterator<decltype(view.begin())>);
+  ASSERT_EQ(view.size(), 12);
+  ASSERT_EQ(std::ranges::distance(view), 12);
+
+  std::iota(view.begin(), view.end(), 1);
+  EXPECT_EQ((a[0, 0]), 1);
+  EXPECT_EQ((a[0, 2]), 2);
+  EXPECT_EQ((a[0, 1]), 0);
+  EXPECT_EQ((a[3, 0]), 10);
+  EXPECT_EQ((a[3, 4]), 12);
+
+  // Random access and backwards iteration
+  auto it = view.begin() + 6;
+  EXPECT_EQ(*it, 7);
+  EXPECT_EQ(it.index(), (std::array<size_t, 2>{2, 0}));
+  EXPECT_EQ(it[-3], 4);
+  --it;
+  EXPECT_EQ(*it, 6);
+  EXPECT_EQ(view.end() - it, 7);
+  const auto reversed = view | std::views::reverse;
+  EXPECT_EQ(*reversed.begin(), 12);
+  EXPECT_EQ(*std::ranges::prev(reversed.end()), 1);
+
+  // Padded layouts iterate the indices in layout_right order, skipping the padding
+  Igor::MdArray<int, std::dextents<size_t, 2>, Igor::layout_padded<8>> padded(
+      Igor::zero_init, 3, 5);
+  std::iota(padded.begin(), padded.end(), 0);
+  EXPECT_EQ((padded[2, 4]), 14);
+  EXPECT_EQ(std::reduce(std::execution::par, padded.begin(), padded.end()), 105);
+}
+
+TEST(TestMdIterator, ProxyReference) {
+  Igor::ReducedPrecisionMdArray<Igor::float16, std::dextents<size_t, 2>> half(2, 3);
+  static_assert(std::ranges::random_access_range<decltype(half)>);
+  const std::vector<float> values = {1.0F, 2.0F, 0.5F, -1.0F, 8.0F, 0.25F};
+  std::ranges::copy(values, half.begin());
+  EXPECT_FLOAT_EQ((half[1, 0]), -1.0F);
+  EXPECT_FLOAT_EQ(*std::ranges::max_element(half), 8.0F);
+  EXPECT_FLOAT_EQ(std::accumulate(half.begin(), half.end(), 0.0F), 10.75F);
+}
@@ -0,0 +1,326 @@
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <complex>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include <Igor/MdArray.hpp>
+#include <Igor/MdspanToNpy.hpp>
+#include <Igor/NpyToMdArray.hpp>
+
+TEST(TestNpyToMdArray, RoundTrip) {
+  constexpr size_t m  = 23;
+  constexpr size_t n  = 71;
+  constexpr size_t k  = 5;
+  const auto filename = std::filesystem::temp_directory_path() / "igor_test_npy_to_mdarray.npy";
+
+  {
+    Igor::MdArray<double, std::dextents<size_t, 3>> a(m, n, k);
+    for (size_t i = 0; i < a.size(); ++i) {
+      a.get_data()[i] = static_cast<double>(i) / 7.0;  // NOLINT
+    }
+    ASSERT_TRUE(Igor::mdspan_to_npy(a, filename.string()));
+
+    const auto b = Igor::npy_to_mdarray<double, std::dextents<size_t, 3>>(filename.string());
+    ASSERT_TRUE(b.has_value());
+    ASSERT_EQ(b->extents(), a.extents());
+    for (size_t i = 0; i < m; ++i) {
+      for (size_t j = 0; j < n; ++j) {
+        for (size_t l = 0; l < k; ++l) {
+          ASSERT_EQ((b->operator[](i, j, l)), (a[i, j, l]));
+        }
+      }
+    }
+
+    // Static extents must match, dynamic extents are taken from the header
+    EXPECT_TRUE((Igor::npy_to_mdarray<double, std::extents<size_t, m, std::dynamic_extent, k>>(
+                     filename.string())
+                     .has_value()));
+    EXPECT_FALSE((Igor::npy_to_mdarray<double, std::extents<size_t, m, n, k + 1>>(
+                      filename.string())
+                      .has_value()));
+    EXPECT_FALSE(
+        (Igor::npy_to_mdarray<float, std::dextents<size_t, 3>>(filename.string()).has_value()));
+    EXPECT_FALSE(
+        (Igor::npy_to_mdarray<double, std::dextents<size_t, 2>>(filename.string()).has_value()));
+    EXPECT_FALSE((Igor::npy_to_mdarray<double, std::dextents<size_t, 3>, std::layout_left>(
+                      filename.string())
+                      .has_value()));
+
+    const auto mapped = Igor::map_npy<const double, std::dextents<size_t, 3>>(filename.string());
+    ASSERT_TRUE(mapped.has_value());
+    EXPECT_EQ(((*mapped)[m - 1, n - 1, k - 1]), (a[m - 1, n - 1, k - 1]));
+  }
+
+  {
+    Igor::MdArray<float, std::extents<size_t, m, std::dynamic_extent>, std::layout_left> a(n);
+    for (size_t i = 0; i < a.size(); ++i) {
+      a.get_data()[i] = static_cast<float>(i) * 0.25F;  // NOLINT
+    }
+    ASSERT_TRUE(Igor::mdspan_to_npy(a, filename.string()));
+
+    const auto b =
+        Igor::npy_to_mdarray<float, std::dextents<size_t, 2>, std::layout_left>(filename.string());
+    ASSERT_TRUE(b.has_value());
+    ASSERT_EQ(b->extent(0), m);
+    ASSERT_EQ(b->extent(1), n);
+    for (size_t j = 0; j < n; ++j) {
+      for (size_t i = 0; i < m; ++i) {
+        ASSERT_EQ((b->operator[](i, j)), (a[i, j]));
+      }
+    }
+  }
+
+  std::filesystem::remove(filename);
+}
+
+TEST(TestNpyToMdArray, StridedViews) {
+  constexpr int m     = 8;
+  constexpr int n     = 9;
+  constexpr int k     = 10;
+  const auto filename = std::filesystem::temp_directory_path() / "igor_test_npy_strided.npy";
+  using Extents       = std::dextents<int, 3>;
+  using Strided       = std::mdspan<const double, Extents, std::layout_stride>;
+
+  Igor::MdArray<double, Extents> a(m, n, k);
+  for (size_t i = 0; i < a.size(); ++i) {
+    a.get_data()[i] = static_cast<double>(i);  // NOLINT
+  }
+
+  const auto check = [&](const Strided& view) {
+    ASSERT_TRUE(Igor::mdspan_to_npy(view, filename.string()));
+    const auto b = Igor::npy_to_mdarray<double, Extents>(filename.string());
+    ASSERT_TRUE(b.has_value());
+    ASSERT_EQ(b->extents(), view.extents());
+    for (int i = 0; i < view.extent(0); ++i) {
+      for (int j = 0; j < view.extent(1); ++j) {
+        for (int l = 0; l < view.extent(2); ++l) {
+          ASSERT_EQ((b->operator[](i, j, l)), (view[i, j, l]));
+        }
+      }
+    }
+  };
+
+  // Slice [2:4, :, :], contiguous in C order
+  check(Strided(&a[2, 0, 0],
+                std::layout_stride::mapping(Extents(2, n, k), std::array{n * k, k, 1})));
+  // Interior region [1:7, 2:8, 3:9], contiguous rows
+  check(Strided(&a[1, 2, 3],
+                std::layout_stride::mapping(Extents(6, 6, 6), std::array{n * k, k, 1})));
+  // Every other element of the last dimension
+  check(Strided(a.get_data(),
+                std::layout_stride::mapping(Extents(m, n, k / 2), std::array{n * k, k, 2})));
+  // Transposed
+  check(Strided(a.get_data(),
+                std::layout_stride::mapping(Extents(k, n, m), std::array{1, k, n * k})));
+
+  // Rows longer than the staging buffer are written directly
+  constexpr int long_row = static_cast<int>(Igor::detail::NPY_STAGING_BYTES / sizeof(double)) + 3;
+  Igor::MdArray<double, Extents> b(2, 2, long_row + 1);
+  for (size_t i = 0; i < b.size(); ++i) {
+    b.get_data()[i] = static_cast<double>(i) * 0.5;  // NOLINT
+  }
+  check(Strided(&b[0, 0, 1],
+                std::layout_stride::mapping(Extents(2, 2, long_row),
+                                            std::array{2 * (long_row + 1), long_row + 1, 1})));
+
+#if defined(__cpp_lib_submdspan)
+  {
+    const auto interior = std::submdspan(a,
+                                         std::pair{1, 7},
+                                         std::full_extent,
+                                         std::strided_slice{.offset = 1, .extent = 8, .stride = 3});
+    ASSERT_TRUE(Igor::mdspan_to_npy(interior, filename.string()));
+    const auto c = Igor::npy_to_mdarray<double, Extents>(filename.string());
+    ASSERT_TRUE(c.has_value());
+    EXPECT_EQ((c->operator[](5, n - 1, 2)), (a[6, n - 1, 7]));
+  }
+#endif
+
+  std::filesystem::remove(filename);
+}
+
+namespace {
+
+template <typename T>
+void check_dtype_round_trip(const std::string& expected_descr) {
+  constexpr size_t m  = 7;
+  constexpr size_t n  = 11;
+  const auto filename = std::filesystem::temp_directory_path() / "igor_test_npy_dtype.npy";
+
+  Igor::MdArray<T, std::dextents<size_t, 2>> a(m, n);
+  for (size_t i = 0; i < m; ++i) {
+    for (size_t j = 0; j < n; ++j) {
+      if constexpr (std::is_same_v<T, bool>) {
+        a[i, j] = (i + j) % 3 == 0;
+      } else if constexpr (Igor::detail::is_npy_complex<T>::value) {
+        a[i, j] = T(static_cast<T::value_type>(i), -static_cast<T::value_type>(j));
+      } else {
+        a[i, j] = static_cast<T>(i * n + j - 20);
+      }
+    }
+  }
+  ASSERT_TRUE(Igor::mdspan_to_npy(a, filename.string()));
+
+  std::ifstream in(filename, std::ios::binary);
+  const auto header = Igor::detail::read_npy_header(in, filename.string());
+  ASSERT_TRUE(header.has_value());
+  EXPECT_EQ(header->descr, expected_descr);
+  EXPECT_EQ(std::filesystem::file_size(filename), header->data_offset + m * n * sizeof(T));
+  // The header length is stored little-endian independent of the host
+  in.seekg(8);
+  const int len_low  = in.get();
+  const int len_high = in.get();
+  EXPECT_EQ(static_cast<size_t>(len_low | (len_high << 8)) + 10UZ, header->data_offset);
+
+  const auto b = Igor::npy_to_mdarray<T, std::dextents<size_t, 2>>(filename.string());
+  ASSERT_TRUE(b.has_value());
+  EXPECT_TRUE(std::equal(a.get_data(), a.get_data() + a.size(), b->get_data()));  // NOLINT
+
+  // Strided views are staged without converting the elements
+  using Strided = std::mdspan<const T, std::dextents<size_t, 2>, std::layout_stride>;
+  for (const size_t stride : {1UZ, 2UZ}) {
+    const Strided view(&a[0, 1],
+                       std::layout_stride::mapping(std::dextents<size_t, 2>(m, (n - 1) / stride),
+                                                   std::array{n, stride}));
+    ASSERT_TRUE(Igor::mdspan_to_npy(view, filename.string()));
+    const auto c = Igor::npy_to_mdarray<T, std::dextents<size_t, 2>>(filename.string());
+    ASSERT_TRUE(c.has_value());
+    for (size_t i = 0; i < view.extent(0); ++i) {
+      for (size_t j = 0; j < view.extent(1); ++j) {
+        ASSERT_EQ((c->operator[](i, j)), (view[i, j]));
+      }
+    }
+  }
+  std::filesystem::remove(filename);
+}
+
+}  // namespace
+
+TEST(TestNpyToMdArray, Dtypes) {
+  const char bo = std::endian::native == std::endian::little ? '<' : '>';
+  check_dtype_round_trip<std::int8_t>("|i1");
+  check_dtype_round_trip<std::uint8_t>("|u1");
+  check_dtype_round_trip<std::int16_t>(bo + std::string("i2"));
+  check_dtype_round_trip<std::uint16_t>(bo + std::string("u2"));
+  check_dtype_round_trip<std::int32_t>(bo + std::string("i4"));
+  check_dtype_round_trip<std::uint32_t>(bo + std::string("u4"));
+  check_dtype_round_trip<std::int64_t>(bo + std::string("i8"));
+  check_dtype_round_trip<std::uint64_t>(bo + std::string("u8"));
+  check_dtype_round_trip<std::complex<float>>(bo + std::string("c8"));
+  check_dtype_round_trip<std::complex<double>>(bo + std::string("c16"));
+  check_dtype_round_trip<bool>("|b1");
+}
+
+TEST(TestNpyToMdArray, ByteOrder) {
+  using namespace std::string_literals;
+  const auto filename = std::filesystem::temp_directory_path() / "igor_test_npy_byte_order.npy";
+
+  // Elements in the opposite byte order of the machine are swapped after reading
+  const std::array<std::int32_t, 3> values{1, -2, 0x01020304};
+  const std::array<std::complex<double>, 2> complex_values{{{1.5, -2.0}, {0.25, 8.0}}};
+  const auto write_swapped = [&](auto data) {
+    using T     = typename decltype(data)::value_type;
+    auto header = "{'descr': '"s + Igor::detail::npy_descr<T>(true) +
+                  "', 'fortran_order': False, 'shape': ("s + std::to_string(data.size()) + ",), }"s;
+    header.resize(128UZ - 10UZ - 1UZ, ' ');
+    header += '\n';
+    Igor::detail::npy_byteswap(data.data(), data.size());
+    std::ofstream out(filename, std::ios::binary);
+    out << "\x93NUMPY\x01\x00"s << static_cast<char>(header.size()) << '\0' << header;
+    out.write(reinterpret_cast<const char*>(data.data()),  // NOLINT
+              static_cast<std::streamsize>(data.size() * sizeof(T)));
+  };
+
+  const char swapped_order = std::endian::native == std::endian::little ? '>' : '<';
+  EXPECT_EQ(Igor::detail::npy_descr<std::int32_t>(true), swapped_order + "i4"s);
+  EXPECT_EQ(Igor::detail::npy_descr<std::complex<double>>(true), swapped_order + "c16"s);
+  EXPECT_EQ(Igor::detail::npy_descr<std::uint8_t>(true), "|u1");
+
+  write_swapped(values);
+  const auto a = Igor::npy_to_mdarray<std::int32_t, std::dextents<size_t, 1>>(filename.string());
+  ASSERT_TRUE(a.has_value());
+  EXPECT_TRUE(std::equal(values.begin(), values.end(), a->get_data()));
+  // Mapping cannot swap the elements
+  EXPECT_FALSE(
+      (Igor::map_npy<const std::int32_t, std::dextents<size_t, 1>>(filename.string()).has_value()));
+
+  write_swapped(complex_values);
+  const auto b =
+      Igor::npy_to_mdarray<std::complex<double>, std::dextents<size_t, 1>>(filename.string());
+  ASSERT_TRUE(b.has_value());
+  EXPECT_TRUE(std::equal(complex_values.begin(), complex_values.end(), b->get_data()));
+
+  std::filesystem::remove(filename);
+}
+
+TEST(TestNpyToMdArray, HeaderVersions) {
+  using namespace std::string_literals;
+  const auto filename = std::filesystem::temp_directory_path() / "igor_test_npy_v2.npy";
+  const std::array<double, 6> data{1.0, 2.0, 3.0, 4.0, 5.0, 6.0};
+
+  // Version 2.0 with a four byte header length, padded to a multiple of 64 bytes
+  auto header = "{'descr': '<f8', 'fortran_order': False, 'shape': (2, 3), }"s;
+  header.resize(128UZ - 12UZ - 1UZ, ' ');
+  header += '\n';
+  {
+    std::ofstream out(filename, std::ios::binary);
+    out << "\x93NUMPY\x02\x00"s << static_cast<char>(header.size()) << "\x00\x00\x00"s << header;
+    out.write(reinterpret_cast<const char*>(data.data()),  // NOLINT
+              static_cast<std::streamsize>(data.size() * sizeof(double)));
+  }
+  const auto a = Igor::npy_to_mdarray<double, std::dextents<int, 2>>(filename.string());
+  ASSERT_TRUE(a.has_value());
+  ASSERT_EQ(a->extent(0), 2);
+  ASSERT_EQ(a->extent(1), 3);
+  EXPECT_EQ((a->operator[](1, 2)), 6.0);
+  EXPECT_EQ((a->operator[](0, 1)), 2.0);
+
+  // Truncated payload
+  std::filesystem::resize_file(filename, 128UZ + 5UZ * sizeof(double));
+  EXPECT_FALSE(
+      (Igor::npy_to_mdarray<double, std::dextents<int, 2>>(filename.string()).has_value()));
+
+  // Shapes that do not fit into the file are rejected before allocating
+  for (const auto* shape : {"(1099511627776, 3)", "(4611686018427387904, 4611686018427387904)"}) {
+    auto huge_header = "{'descr': '<f8', 'fortran_order': False, 'shape': "s + shape + ", }"s;
+    huge_header.resize(128UZ - 12UZ - 1UZ, ' ');
+    huge_header += '\n';
+    {
+      std::ofstream out(filename, std::ios::binary);
+      out << "\x93NUMPY\x02\x00"s << static_cast<char>(huge_header.size()) << "\x00\x00\x00"s
+          << huge_header;
+      out.write(reinterpret_cast<const char*>(data.data()),  // NOLINT
+                static_cast<std::streamsize>(data.size() * sizeof(double)));
+    }
+    EXPECT_FALSE(
+        (Igor::npy_to_mdarray<double, std::dextents<size_t, 2>>(filename.string()).has_value()));
+  }
+
+  // Header length beyond the limit
+  {
+    std::ofstream out(filename, std::ios::binary);
+    out << "\x93NUMPY\x02\x00"s << "\xF0\xFF\xFF\xFF"s << header;
+  }
+  testing::internal::CaptureStderr();
+  EXPECT_FALSE(
+      (Igor::npy_to_mdarray<double, std::dextents<int, 2>>(filename.string()).has_value()));
+  EXPECT_NE(testing::internal::GetCapturedStderr().find("at most 10000 bytes"), std::string::npos);
+
+  // Not an npy file
+  {
+    std::ofstream out(filename, std::ios::binary);
+    out << "NUMPY";
+  }
+  EXPECT_FALSE(
+      (Igor::npy_to_mdarray<double, std::dextents<int, 2>>(filename.string()).has_value()));
+  std::filesystem::remove(filename);
+
+  EXPECT_FALSE(
+      (Igor::npy_to_mdarray<double, std::dextents<int, 2>>(filename.string()).has_value()));
+}
@@ -0,0 +1,128 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <Igor/Parallel.hpp>
+
+TEST(TestParallel, StaticChunk) {
+  // Same decomposition as OpenMP's schedule(static): the first `n % num_threads` threads get one
+  // additional element
+  constexpr size_t num_threads = 4;
+  size_t expected_begin        = 10;
+  for (size_t thread_id = 0; thread_id < num_threads; ++thread_id) {
+    const auto [begin, end] = Igor::detail::static_chunk(10, 20, thread_id, num_threads);
+    EXPECT_EQ(begin, expected_begin);
+    EXPECT_EQ(end - begin, thread_id < 2 ? 3UZ : 2UZ);
+    expected_begin = end;
+  }
+  EXPECT_EQ(expected_begin, 20);
+}
+
+TEST(TestParallel, ParallelFor) {
+  constexpr size_t n = 1000;
+  std::vector<std::atomic<int>> visited(n);
+  for (size_t num_threads : {1UZ, 3UZ, 8UZ, 2000UZ}) {
+    for (auto& v : visited) {
+      v = 0;
+    }
+    Igor::parallel_for(0UZ, n, [&](size_t i) { visited[i].fetch_add(1); }, num_threads);
+    for (const auto& v : visited) {
+      EXPECT_EQ(v.load(), 1);
+    }
+  }
+
+  Igor::set_num_threads(3);
+  EXPECT_EQ(Igor::num_threads(), 3);
+  Igor::set_num_threads(0);
+  EXPECT_GE(Igor::num_threads(), 1);
+}
+
+TEST(TestParallel, NestedAndRepeated) {
+  // Worker threads are reused and nested regions run sequentially on the calling thread
+  constexpr size_t n = 64;
+  std::vector<std::atomic<int>> visited(n * n);
+  for (int repetition = 0; repetition < 100; ++repetition) {
+    Igor::parallel_for(
+        0UZ,
+        n,
+        [&](size_t i) {
+          Igor::parallel_for(0UZ, n, [&](size_t j) { visited[i * n + j].fetch_add(1); }, 4UZ);
+        },
+        4UZ);
+  }
+  for (const auto& v : visited) {
+    EXPECT_EQ(v.load(), 100);
+  }
+}
+
+TEST(TestParallel, Fork) {
+  // Start the workers of the pool before forking, the child has to start its own
+  constexpr size_t n = 256;
+  std::vector<std::atomic<int>> visited(n);
+  Igor::parallel_for(0UZ, n, [&](size_t i) { visited[i].fetch_add(1); }, 4UZ);
+
+  const pid_t pid = fork();
+  ASSERT_NE(pid, -1);
+  if (pid == 0) {
+    // Kill the child instead of hanging if the pool waits for workers that do not exist
+    alarm(10);
+    for (int repetition = 0; repetition < 10; ++repetition) {
+      Igor::parallel_for(0UZ, n, [&](size_t i) { visited[i].fetch_add(1); }, 4UZ);
+    }
+    for (const auto& v : visited) {
+      if (v.load() != 11) { _exit(1); }
+    }
+    _exit(0);
+  }
+
+  int status = 0;
+  ASSERT_EQ(waitpid(pid, &status, 0), pid);
+  EXPECT_TRUE(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+
+  // The pool of the parent is unaffected
+  Igor::parallel_for(0UZ, n, [&](size_t i) { visited[i].fetch_add(1); }, 4UZ);
+  for (const auto& v : visited) {
+    EXPECT_EQ(v.load(), 2);
+  }
+}
+
+TEST(TestParallel, ForkDuringRegion) {
+  // Another thread keeps starting parallel regions while forking, the fork waits for the running
+  // region s.t. the child never inherits a pool in the middle of a region
+  constexpr size_t n     = 256;
+  std::atomic<bool> stop = false;
+  std::thread background([&] {
+    std::vector<std::atomic<int>> counts(n);
+    while (!stop.load()) {
+      Igor::parallel_for(0UZ, n, [&](size_t i) { counts[i].fetch_add(1); }, 4UZ);
+    }
+  });
+
+  for (int repetition = 0; repetition < 5; ++repetition) {
+    const pid_t pid = fork();
+    if (pid == -1) {
+      ADD_FAILURE() << "fork failed";
+      break;
+    }
+    if (pid == 0) {
+      alarm(10);
+      std::vector<std::atomic<int>> visited(n);
+      Igor::parallel_for(0UZ, n, [&](size_t i) { visited[i].fetch_add(1); }, 4UZ);
+      for (const auto& v : visited) {
+        if (v.load() != 1) { _exit(1); }
+      }
+      _exit(0);
+    }
+    int status = 0;
+    EXPECT_EQ(waitpid(pid, &status, 0), pid);
+    EXPECT_TRUE(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+  }
+
+  stop = true;
+  background.join();
+}
@@ -0,0 +1,86 @@
+#include <cmath>
+#include <numeric>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <Igor/MdArray.hpp>
+#include <Igor/Reduce.hpp>
+
+TEST(TestReduce, Contiguous) {
+  // Not a multiple of the vector width to exercise the remainder loop
+  constexpr size_t m = 37UZ;
+  constexpr size_t n = 29UZ;
+  Igor::MdArray<double, std::dextents<size_t, 2>> a(m, n);
+  Igor::MdArray<double, std::dextents<size_t, 2>> b(m, n);
+  double expected_sum = 0.0;
+  double expected_sq  = 0.0;
+  double expected_dot = 0.0;
+  for (size_t i = 0; i < m; ++i) {
+    for (size_t j = 0; j < n; ++j) {
+      a[i, j] = static_cast<double>(i) - static_cast<double>(j) * 1.5;
+      b[i, j] = 0.5 + static_cast<double>(j);
+      expected_sum += a[i, j];
+      expected_sq += a[i, j] * a[i, j];
+      expected_dot += a[i, j] * b[i, j];
+    }
+  }
+
+  for (size_t n_threads : {1UZ, 3UZ}) {
+    EXPECT_NEAR(Igor::sum(a, n_threads), expected_sum, 1e-9);
+    EXPECT_DOUBLE_EQ(Igor::max_abs(a, n_threads), 28.0 * 1.5);
+    EXPECT_NEAR(Igor::l2_norm(a, n_threads), std::sqrt(expected_sq), 1e-9);
+    EXPECT_NEAR(Igor::dot(a, b, n_threads), expected_dot, 1e-6);
+    const auto [min, max] = Igor::minmax(a, n_threads);
+    EXPECT_DOUBLE_EQ(min, -28.0 * 1.5);
+    EXPECT_DOUBLE_EQ(max, 36.0);
+  }
+}
+
+TEST(TestReduce, Integer) {
+  std::vector<int> data(1001);
+  std::iota(data.begin(), data.end(), -500);
+  const std::mdspan<const int, std::dextents<size_t, 1>> span(data.data(), data.size());
+
+  EXPECT_EQ(Igor::sum(span), 0);
+  EXPECT_EQ(Igor::max_abs(span), 500);
+  EXPECT_EQ(Igor::dot(span, span, 4UZ), 2 * 500 * 501 * 1001 / 6);
+  EXPECT_EQ(Igor::minmax(span), std::make_pair(-500, 500));
+
+  const std::mdspan<const int, std::dextents<size_t, 1>> empty(data.data(), 0UZ);
+  EXPECT_EQ(Igor::sum(empty, 4UZ), 0);
+  EXPECT_EQ(Igor::max_abs(empty), 0);
+}
+
+TEST(TestReduce, Strided) {
+  constexpr size_t m = 6UZ;
+  constexpr size_t n = 8UZ;
+  Igor::MdArray<float, std::dextents<size_t, 2>, std::layout_left> a(m, n);
+  Igor::MdArray<float, std::dextents<size_t, 2>> b(m, n);
+  for (size_t i = 0; i < m; ++i) {
+    for (size_t j = 0; j < n; ++j) {
+      a[i, j] = static_cast<float>(i * n + j);
+      b[i, j] = 2.0F;
+    }
+  }
+
+  // Mixed layouts and layout_stride take the multi-index path
+  const float expected = static_cast<float>((m * n - 1) * m * n);
+  EXPECT_FLOAT_EQ(Igor::dot(a, b), expected);
+  EXPECT_FLOAT_EQ(Igor::dot(a, b, 2UZ), expected);
+
+  // Every other column of a
+  const std::layout_stride::mapping strided_mapping(std::dextents<size_t, 2>(m, n / 2),
+                                                    std::array<size_t, 2>{1UZ, 2UZ * m});
+  const std::mdspan<float, std::dextents<size_t, 2>, std::layout_stride> strided(a.get_data(),
+                                                                                 strided_mapping);
+  float expected_sum = 0.0F;
+  for (size_t i = 0; i < m; ++i) {
+    for (size_t j = 0; j < n; j += 2) {
+      expected_sum += a[i, j];
+    }
+  }
+  EXPECT_FLOAT_EQ(Igor::sum(strided), expected_sum);
+  EXPECT_FLOAT_EQ(Igor::sum(strided, 2UZ), expected_sum);
+  EXPECT_EQ(Igor::minmax(strided), std::make_pair(0.0F, a[m - 1, n - 2]));
+}
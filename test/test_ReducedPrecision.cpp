@@ -0,0 +1,116 @@
+#include <cmath>
+#include <filesystem>
+#include <limits>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <Igor/MdArray.hpp>
+#include <Igor/MdspanToNpy.hpp>
+#include <Igor/NpyToMdArray.hpp>
+#include <Igor/ReducedPrecision.hpp>
+
+TEST(TestReducedPrecision, Conversion) {
+  // Exactly representable values
+  for (const float f : {0.0F, -0.0F, 1.0F, -2.5F, 65504.0F, 0.000061035156F, 5.9604645e-8F}) {
+    EXPECT_EQ(Igor::to_float(Igor::from_float<Igor::float16>(f)), f);
+    EXPECT_EQ(Igor::detail::half_bits_to_float(Igor::detail::float_to_half_bits(f)), f);
+  }
+  EXPECT_EQ(Igor::from_float<Igor::float16>(1.0F).bits, 0x3C00);
+  EXPECT_EQ(Igor::detail::float_to_half_bits(1.0F), 0x3C00);
+  EXPECT_EQ(Igor::from_float<Igor::bfloat16>(1.0F).bits, 0x3F80);
+
+  // Round to nearest even, overflow and NaN
+  EXPECT_EQ(Igor::detail::float_to_half_bits(1.0F + 0x1p-11F), 0x3C00);
+  EXPECT_EQ(Igor::detail::float_to_half_bits(1.0F + 0x3p-11F), 0x3C02);
+  EXPECT_EQ(Igor::detail::float_to_half_bits(1e6F), 0x7C00);
+  EXPECT_TRUE(std::isnan(Igor::to_float(
+      Igor::from_float<Igor::float16>(std::numeric_limits<float>::quiet_NaN()))));
+  EXPECT_EQ(Igor::from_float<Igor::bfloat16>(1.0F + 0x1p-8F).bits, 0x3F80);
+  EXPECT_EQ(Igor::from_float<Igor::bfloat16>(1.0F + 0x3p-8F).bits, 0x3F82);
+  EXPECT_TRUE(std::isnan(Igor::to_float(
+      Igor::from_float<Igor::bfloat16>(std::numeric_limits<float>::quiet_NaN()))));
+  static_assert(Igor::to_float(Igor::from_float<Igor::float16>(0.5F)) == 0.5F);
+
+  // Bulk conversion agrees with the scalar conversion, including the tail
+  std::vector<float> values(37);
+  for (size_t i = 0; i < values.size(); ++i) {
+    values[i] = static_cast<float>(i) * 0.37F - 5.0F;
+  }
+  std::vector<Igor::float16> half(values.size());
+  std::vector<float> back(values.size());
+  Igor::convert_n(values.data(), values.size(), half.data());
+  Igor::convert_n(static_cast<const Igor::float16*>(half.data()), half.size(), back.data());
+  for (size_t i = 0; i < values.size(); ++i) {
+    EXPECT_EQ(half[i].bits, Igor::detail::float_to_half_bits(values[i]));
+    EXPECT_NEAR(back[i], values[i], 5e-3F);
+  }
+}
+
+TEST(TestReducedPrecision, MdArray) {
+  constexpr size_t m = 13;
+  constexpr size_t n = 17;
+  Igor::MdArray<float, std::dextents<size_t, 2>> ref(m, n);
+  for (size_t i = 0; i < m; ++i) {
+    for (size_t j = 0; j < n; ++j) {
+      ref[i, j] = static_cast<float>(i) + static_cast<float>(j) / 16.0F;
+    }
+  }
+
+  Igor::ReducedPrecisionMdArray<Igor::float16, std::dextents<size_t, 2>> half(
+      Igor::zero_init, m, n);
+  static_assert(sizeof(*half.get_data()) == 2);
+  half.copy_from(ref);
+  EXPECT_FLOAT_EQ((half[3, 5]), 3.3125F);
+  half[3, 5] += 1.0F;
+  EXPECT_FLOAT_EQ((half[3, 5]), 4.3125F);
+
+  Igor::ReducedPrecisionMdArray<Igor::bfloat16, std::dextents<size_t, 2>, std::layout_left> brain(
+      m, n);
+  brain.copy_from(ref);
+  EXPECT_FLOAT_EQ((brain[12, 16]), 13.0F);
+  EXPECT_FLOAT_EQ((brain[2, 3]), 2.1875F);
+
+  // Back to float, and a read-only view
+  Igor::MdArray<float, std::dextents<size_t, 2>> widened(m, n);
+  widened.copy_from(half);
+  EXPECT_FLOAT_EQ((widened[3, 5]), 4.3125F);
+  EXPECT_FLOAT_EQ((widened[12, 16]), 13.0F);
+  const std::mdspan<const float,
+                    std::dextents<size_t, 2>,
+                    std::layout_right,
+                    Igor::reduced_precision_accessor<const Igor::float16>>
+      view = half;
+  EXPECT_FLOAT_EQ((view[3, 5]), 4.3125F);
+}
+
+TEST(TestReducedPrecision, Npy) {
+  Igor::ReducedPrecisionMdArray<Igor::float16, std::dextents<size_t, 2>> half(3, 4);
+  for (size_t i = 0; i < 3; ++i) {
+    for (size_t j = 0; j < 4; ++j) {
+      half[i, j] = static_cast<float>(4 * i + j);
+    }
+  }
+  const auto filename = std::filesystem::temp_directory_path() / "igor_test_half.npy";
+  ASSERT_TRUE(Igor::mdspan_to_npy(half, filename.string()));
+
+  // float16 is written as is, i.e. it cannot be read back as float
+  const auto half_read =
+      Igor::npy_to_mdarray<Igor::float16, std::dextents<size_t, 2>>(filename.string());
+  ASSERT_TRUE(half_read.has_value());
+  ASSERT_EQ(half_read->extents(), half.extents());
+  EXPECT_FLOAT_EQ(Igor::to_float(half_read->operator[](1, 3)), 7.0F);
+  EXPECT_FALSE(
+      (Igor::npy_to_mdarray<float, std::dextents<size_t, 2>>(filename.string()).has_value()));
+
+  // bfloat16 is widened to float
+  Igor::ReducedPrecisionMdArray<Igor::bfloat16, std::dextents<size_t, 1>> brain(5);
+  brain[4] = 2.0F;
+  ASSERT_TRUE(Igor::mdspan_to_npy(brain, filename.string()));
+  const auto brain_read = Igor::npy_to_mdarray<float, std::dextents<size_t, 1>>(filename.string());
+  ASSERT_TRUE(brain_read.has_value());
+  ASSERT_EQ(brain_read->extent(0), 5);
+  EXPECT_FLOAT_EQ(brain_read->operator[](4), 2.0F);
+
+  std::filesystem::remove(filename);
+}
@@ -0,0 +1,93 @@
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <Igor/MdArray.hpp>
+#include <Igor/Parallel.hpp>
+#include <Igor/ScatterAdd.hpp>
+
+namespace {
+
+// Deterministic cell of particle `p` in an n x n grid, many particles share a cell
+[[nodiscard]] constexpr auto particle_cell(size_t p, size_t n) noexcept
+    -> std::pair<size_t, size_t> {
+  return {(p * 7UZ) % n, (p * 13UZ + p / n) % n};
+}
+
+}  // namespace
+
+TEST(TestScatterAdd, AtomicAccessor) {
+  constexpr size_t n           = 8;
+  constexpr size_t n_particles = 10'000;
+  Igor::MdArray<long, std::dextents<size_t, 2>, std::layout_right, Igor::atomic_accessor<long>>
+      grid(Igor::zero_init, n, n);
+  Igor::parallel_for(
+      0UZ,
+      n_particles,
+      [&](size_t p) {
+        const auto [i, j] = particle_cell(p, n);
+        grid[i, j] += 2;
+        grid[j, i] -= 1;
+      },
+      4UZ);
+
+  std::vector<long> expected(n * n, 0);
+  for (size_t p = 0; p < n_particles; ++p) {
+    const auto [i, j] = particle_cell(p, n);
+    expected[i * n + j] += 2;
+    expected[j * n + i] -= 1;
+  }
+  for (size_t i = 0; i < n; ++i) {
+    for (size_t j = 0; j < n; ++j) {
+      EXPECT_EQ(static_cast<long>(grid[i, j]), expected[i * n + j]);
+    }
+  }
+
+  // Atomic view of a plain array with floating point elements
+  Igor::MdArray<double, std::dextents<size_t, 1>> a(Igor::zero_init, 3);
+  const auto atomic = Igor::atomic_view(a);
+  Igor::parallel_for(0UZ, 4000UZ, [&](size_t p) { atomic[p % 3] += 0.5; }, 4UZ);
+  EXPECT_DOUBLE_EQ(a[0], 667.0);
+  EXPECT_DOUBLE_EQ(a[2], 666.5);
+  atomic[1] = -1.0;
+  EXPECT_DOUBLE_EQ(static_cast<double>(atomic[1]), -1.0);
+}
+
+TEST(TestScatterAdd, PrivatizedReducer) {
+  constexpr size_t n           = 9;
+  constexpr size_t n_particles = 5'000;
+  Igor::MdArray<double, std::dextents<size_t, 2>, std::layout_left> grid(n, n);
+  Igor::MdArray<double, std::dextents<size_t, 2>, std::layout_left> expected(n, n);
+  for (size_t i = 0; i < n; ++i) {
+    for (size_t j = 0; j < n; ++j) {
+      grid[i, j]     = 1.0;
+      expected[i, j] = 1.0;
+    }
+  }
+  for (size_t p = 0; p < n_particles; ++p) {
+    const auto [i, j] = particle_cell(p, n);
+    expected[i, j] += 0.25;
+  }
+
+  Igor::PrivatizedReducer reducer(grid, 3UZ);
+  ASSERT_EQ(reducer.n_threads(), 3);
+  reducer.scatter(0UZ, n_particles, [](size_t p, const auto& local) {
+    const auto [i, j] = particle_cell(p, n);
+    local[i, j] += 0.25;
+  });
+  for (size_t i = 0; i < n; ++i) {
+    for (size_t j = 0; j < n; ++j) {
+      EXPECT_DOUBLE_EQ((grid[i, j]), (expected[i, j]));
+    }
+  }
+
+  // The private copies are reset by the merge and can be reused manually
+  reducer.local(2)[4, 5] += 3.0;
+  reducer.local(0)[4, 5] += 1.0;
+  reducer.merge();
+  EXPECT_DOUBLE_EQ((grid[4, 5]), (expected[4, 5]) + 4.0);
+  reducer.merge();
+  EXPECT_DOUBLE_EQ((grid[4, 5]), (expected[4, 5]) + 4.0);
+}
@@ -0,0 +1,136 @@
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <gtest/gtest.h>
+
+#include <Igor/SharedMdArray.hpp>
+
+namespace {
+
+[[nodiscard]] auto unique_name(const std::string& suffix) -> std::string {
+  return "/igor_test_" + std::to_string(getpid()) + "_" + suffix;
+}
+
+}  // namespace
+
+TEST(TestSharedMdArray, Attach) {
+  const auto name = unique_name("attach");
+  auto writer     = Igor::SharedMdArray<double, std::dextents<size_t, 2>>::create(name, 5, 7);
+  ASSERT_TRUE(writer.has_value());
+  EXPECT_TRUE(writer->shared_memory().is_owner());
+  EXPECT_EQ(writer->generation(), 0);
+  EXPECT_DOUBLE_EQ(((*writer)[4, 6]), 0.0);
+
+  // The name is taken
+  EXPECT_FALSE(
+      (Igor::SharedMdArray<double, std::dextents<size_t, 2>>::create(name, 1, 1).has_value()));
+
+  writer->write_snapshot([](const auto& view) {
+    for (size_t i = 0; i < view.extent(0); ++i) {
+      for (size_t j = 0; j < view.extent(1); ++j) {
+        view[i, j] = static_cast<double>(10 * i + j);
+      }
+    }
+  });
+  EXPECT_EQ(writer->generation(), 1);
+
+  auto reader =
+      Igor::SharedMdArray<const double, std::extents<size_t, 5, std::dynamic_extent>>::attach(name);
+  ASSERT_TRUE(reader.has_value());
+  EXPECT_FALSE(reader->shared_memory().is_owner());
+  ASSERT_EQ(reader->extent(1), 7);
+  EXPECT_EQ(reader->generation(), 1);
+  EXPECT_DOUBLE_EQ(((*reader)[3, 4]), 34.0);
+
+  // Writes are visible without copying
+  (*writer)[0, 0] = -1.0;
+  EXPECT_DOUBLE_EQ(((*reader)[0, 0]), -1.0);
+
+  std::vector<double> copy;
+  const auto generation = reader->try_read([&](const auto& view) {
+    copy.assign(view.data_handle(), view.data_handle() + view.size());  // NOLINT
+  });
+  ASSERT_TRUE(generation.has_value());
+  EXPECT_EQ(*generation, 1);
+  EXPECT_DOUBLE_EQ(copy[5 * 7 - 1], 46.0);
+
+  // A snapshot in progress cannot be read
+  writer->begin_write();
+  EXPECT_FALSE(reader->try_read([](const auto& /*view*/) {}).has_value());
+  writer->end_write();
+  EXPECT_EQ(reader->generation(), 2);
+
+  // Mismatching element type, layout, static extent and missing segments
+  EXPECT_FALSE((Igor::SharedMdArray<const float, std::dextents<size_t, 2>>::attach(name)));
+  EXPECT_FALSE(
+      (Igor::SharedMdArray<const double, std::dextents<size_t, 2>, std::layout_left>::attach(
+          name)));
+  EXPECT_FALSE((Igor::SharedMdArray<const double, std::extents<size_t, 4, 7>>::attach(name)));
+  EXPECT_FALSE(
+      (Igor::SharedMdArray<const double, std::dextents<size_t, 2>>::attach(unique_name("none"))));
+}
+
+TEST(TestSharedMdArray, StaleSegment) {
+  using Array     = Igor::SharedMdArray<double, std::dextents<size_t, 1>>;
+  const auto name = unique_name("stale");
+  EXPECT_FALSE(Array::remove(name));
+
+  // A writer that dies without cleaning up keeps the name taken
+  const pid_t pid = fork();
+  ASSERT_NE(pid, -1);
+  if (pid == 0) { _exit(Array::create(name, 8).has_value() ? 0 : 1); }
+  int status = 0;
+  ASSERT_EQ(waitpid(pid, &status, 0), pid);
+  ASSERT_TRUE(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+  EXPECT_FALSE(Array::create(name, 8).has_value());
+
+  EXPECT_TRUE(Array::remove(name));
+  auto writer = Array::create(name, 8);
+  ASSERT_TRUE(writer.has_value());
+  EXPECT_TRUE(writer->shared_memory().is_owner());
+}
+
+TEST(TestSharedMdArray, Seqlock) {
+  constexpr size_t n               = 4096;
+  constexpr std::uint64_t n_writes = 200;
+  const auto name                  = unique_name("seqlock");
+  auto writer = Igor::SharedMdArray<double, std::dextents<size_t, 1>>::create(name, n);
+  ASSERT_TRUE(writer.has_value());
+  auto reader = Igor::SharedMdArray<const double, std::dextents<size_t, 1>>::attach(name);
+  ASSERT_TRUE(reader.has_value());
+
+  std::atomic<bool> done = false;
+  std::thread write_thread([&] {
+    for (std::uint64_t g = 1; g <= n_writes; ++g) {
+      writer->write_snapshot([&](const auto& view) {
+        for (size_t i = 0; i < view.size(); ++i) {
+          view[i] = static_cast<double>(g);
+        }
+      });
+    }
+    done = true;
+  });
+
+  // Every snapshot that was read consistently contains a single generation
+  std::vector<double> copy(n);
+  std::uint64_t last_generation = 0;
+  while (!done || last_generation < n_writes) {
+    const auto generation = reader->read_snapshot([&](const auto& view) {
+      for (size_t i = 0; i < view.size(); ++i) {
+        copy[i] = view[i];
+      }
+    });
+    ASSERT_GE(generation, last_generation);
+    for (size_t i = 0; i < n; ++i) {
+      ASSERT_EQ(copy[i], static_cast<double>(generation)) << "Torn snapshot at index " << i;
+    }
+    last_generation = generation;
+  }
+  write_thread.join();
+}
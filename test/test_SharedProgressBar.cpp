@@ -0,0 +1,100 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <string>
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <Igor/SharedProgressBar.hpp>
+
+TEST(TestSharedProgressBar, SingleProcess) {
+  const std::string name = "/igor_test_progress_" + std::to_string(getpid());
+  auto bar               = Igor::SharedProgressBar<>::attach(name, 1, 0, 10, 40);
+  ASSERT_TRUE(bar.has_value());
+  EXPECT_TRUE(bar->is_leader());
+
+  for (int i = 0; i < 4; ++i) {
+    bar->update();
+  }
+  const auto [progress, max_progress] = bar->combined_progress();
+  EXPECT_EQ(progress, 4);
+  EXPECT_EQ(max_progress, 10);
+}
+
+TEST(TestSharedProgressBar, MultipleProcesses) {
+  constexpr std::size_t num_processes = 4;
+  constexpr std::size_t max_progress  = 100;
+  const std::string name              = "/igor_test_progress_multi_" + std::to_string(getpid());
+
+  auto leader = Igor::SharedProgressBar<>::attach(name, num_processes, 0, max_progress, 40);
+  ASSERT_TRUE(leader.has_value());
+  ASSERT_TRUE(leader->is_leader());
+
+  for (std::size_t rank = 1; rank < num_processes; ++rank) {
+    const pid_t pid = fork();
+    ASSERT_NE(pid, -1);
+    if (pid == 0) {
+      auto bar = Igor::SharedProgressBar<>::attach(name, num_processes, rank, max_progress, 40);
+      if (!bar.has_value() || bar->is_leader()) { _exit(1); }
+      for (std::size_t i = 0; i < max_progress; ++i) {
+        bar->update();
+      }
+      _exit(0);
+    }
+  }
+
+  for (std::size_t rank = 1; rank < num_processes; ++rank) {
+    int status = 0;
+    wait(&status);
+    EXPECT_TRUE(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+  }
+
+  leader->update(max_progress / 2);
+  const auto [progress, total] = leader->combined_progress();
+  EXPECT_EQ(progress, (num_processes - 1) * max_progress + max_progress / 2);
+  EXPECT_EQ(total, num_processes * max_progress);
+
+  // Processes with a different number of slots must not attach
+  EXPECT_FALSE(
+      Igor::SharedProgressBar<>::attach(name, num_processes + 1, 1, max_progress, 40).has_value());
+}
+
+TEST(TestSharedProgressBar, StaleSegment) {
+  const std::string name = "/igor_test_progress_stale_" + std::to_string(getpid());
+  EXPECT_FALSE(Igor::SharedProgressBar<>::remove(name));
+
+  // A leader that dies without cleaning up leaves its segment behind
+  const pid_t pid = fork();
+  ASSERT_NE(pid, -1);
+  if (pid == 0) {
+    auto bar = Igor::SharedProgressBar<>::attach(name, 2, 0, 10, 40);
+    if (!bar.has_value()) { _exit(1); }
+    bar->update(7);
+    _exit(0);
+  }
+  int status = 0;
+  waitpid(pid, &status, 0);
+  ASSERT_TRUE(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+
+  // Other processes do not attach to the segment of a dead leader
+  EXPECT_FALSE(Igor::SharedProgressBar<>::attach(name, 2, 1, 10, 40, std::chrono::milliseconds{20})
+                   .has_value());
+
+  // The next leader replaces it and starts from empty slots
+  auto leader = Igor::SharedProgressBar<>::attach(name, 2, 0, 10, 40);
+  ASSERT_TRUE(leader.has_value());
+  EXPECT_TRUE(leader->is_leader());
+  EXPECT_EQ(leader->combined_progress().first, 0);
+
+  auto other = Igor::SharedProgressBar<>::attach(name, 2, 1, 10, 40);
+  ASSERT_TRUE(other.has_value());
+  EXPECT_FALSE(other->is_leader());
+
+  // Waiting for a process that never finishes times out
+  leader->update(10);
+  other->update(5);
+  EXPECT_FALSE(leader->wait_for_all(std::chrono::milliseconds{20}, std::chrono::milliseconds{5}));
+  other->update(5);
+  EXPECT_TRUE(leader->wait_for_all(std::chrono::milliseconds{20}, std::chrono::milliseconds{5}));
+}
@@ -0,0 +1,115 @@
+#include <cstdint>
+#include <tuple>
+
+#include <gtest/gtest.h>
+
+#include <Igor/SoAArray.hpp>
+
+TEST(TestSoAArray, Components) {
+  constexpr size_t nx = 5;
+  constexpr size_t ny = 7;
+  Igor::SoAArray<std::dextents<size_t, 2>, double, float, std::int32_t> field(
+      Igor::zero_init, nx, ny);
+  ASSERT_EQ(field.extent(0), nx);
+  ASSERT_EQ(field.extent(1), ny);
+  ASSERT_EQ(field.size(), nx * ny);
+
+  auto u = field.component<0>();
+  auto p = field.component<1>();
+  auto n = field.component<2>();
+  static_assert(std::is_same_v<decltype(p)::element_type, float>);
+  EXPECT_EQ(reinterpret_cast<std::uintptr_t>(u.data_handle()) % 64, 0);  // NOLINT
+  EXPECT_EQ(reinterpret_cast<std::uintptr_t>(p.data_handle()) % 64, 0);  // NOLINT
+  EXPECT_EQ(reinterpret_cast<std::uintptr_t>(n.data_handle()) % 64, 0);  // NOLINT
+
+  for (size_t i = 0; i < nx; ++i) {
+    for (size_t j = 0; j < ny; ++j) {
+      u[i, j] = static_cast<double>(i * ny + j);
+      p[i, j] = static_cast<float>(i) + 0.5F;
+    }
+  }
+
+  // Cell proxies read and write all components
+  auto cell = field[2, 3];
+  EXPECT_DOUBLE_EQ(cell.get<0>(), 17.0);
+  EXPECT_FLOAT_EQ(cell.get<1>(), 2.5F);
+  EXPECT_EQ(cell.get<2>(), 0);
+  field[4, 6] = std::tuple{-1.0, -2.0F, 3};
+  EXPECT_DOUBLE_EQ((u[4, 6]), -1.0);
+  EXPECT_FLOAT_EQ((p[4, 6]), -2.0F);
+  EXPECT_EQ((n[4, 6]), 3);
+
+  const auto& const_field                    = field;
+  const std::tuple<double, float, int> value = const_field[4, 6];
+  EXPECT_EQ(value, (std::tuple{-1.0, -2.0F, 3}));
+  static_assert(std::is_const_v<decltype(const_field.component<0>())::element_type>);
+
+  // Assigning a cell to a cell copies the values instead of rebinding the proxy
+  field[0, 0] = field[4, 6];
+  EXPECT_DOUBLE_EQ((u[0, 0]), -1.0);
+  EXPECT_FLOAT_EQ((p[0, 0]), -2.0F);
+  EXPECT_EQ((n[0, 0]), 3);
+  field[0, 1] = const_field[2, 3];
+  EXPECT_EQ(static_cast<decltype(value)>(field[0, 1]), (std::tuple{17.0, 2.5F, 0}));
+}
+
+TEST(TestSoAArray, AoSoALayout) {
+  using Layout  = Igor::layout_aosoa<4, 12>;
+  using Mapping = Layout::mapping<std::dextents<size_t, 2>>;
+  const Mapping mapping(std::dextents<size_t, 2>(3, 3));
+  EXPECT_EQ(mapping(0, 0), 0);
+  EXPECT_EQ(mapping(1, 0), 3);
+  EXPECT_EQ(mapping(1, 1), 12);
+  EXPECT_EQ(mapping(2, 2), 24);
+  EXPECT_EQ(mapping.required_span_size(), 28);
+  EXPECT_FALSE(mapping.is_exhaustive());
+  static_assert(Igor::layout_aosoa<8, 8>::mapping<std::extents<size_t, 4, 4>>::is_always_strided());
+}
+
+TEST(TestSoAArray, AoSoA) {
+  constexpr size_t lanes = 8;
+  constexpr size_t nx    = 3;
+  constexpr size_t ny    = 11;
+  Igor::AoSoAArray<std::dextents<size_t, 2>, lanes, float, float, double> field(nx, ny);
+  ASSERT_EQ(field.num_blocks(), 5);
+
+  auto vx = field.component<0>();
+  auto vy = field.component<1>();
+  auto t  = field.component<2>();
+  for (size_t i = 0; i < nx; ++i) {
+    for (size_t j = 0; j < ny; ++j) {
+      vx[i, j] = static_cast<float>(i * ny + j);
+      vy[i, j] = -static_cast<float>(i * ny + j);
+      t[i, j]  = 0.25 * static_cast<double>(i * ny + j);
+    }
+  }
+
+  // Blocks hold LANES consecutive cells of each component next to each other
+  for (size_t b = 0; b < field.num_blocks(); ++b) {
+    const float* bx  = field.component_block<0>(b);
+    const float* by  = field.component_block<1>(b);
+    const double* bt = field.component_block<2>(b);
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(bx) % (lanes * sizeof(float)), 0);  // NOLINT
+    EXPECT_EQ(by, bx + lanes);                                                     // NOLINT
+    for (size_t l = 0; l < lanes && b * lanes + l < field.size(); ++l) {
+      EXPECT_FLOAT_EQ(bx[l], static_cast<float>(b * lanes + l));             // NOLINT
+      EXPECT_FLOAT_EQ(by[l], -static_cast<float>(b * lanes + l));            // NOLINT
+      EXPECT_DOUBLE_EQ(bt[l], 0.25 * static_cast<double>(b * lanes + l));  // NOLINT
+    }
+  }
+
+  field[1, 2] = std::tuple{1.0F, 2.0F, 3.0};
+  EXPECT_FLOAT_EQ((vx[1, 2]), 1.0F);
+  EXPECT_FLOAT_EQ((vy[1, 2]), 2.0F);
+  EXPECT_DOUBLE_EQ((t[1, 2]), 3.0);
+  const auto [x, y, z] = static_cast<std::tuple<float, float, double>>(field[2, 10]);
+  EXPECT_FLOAT_EQ(x, 32.0F);
+  EXPECT_FLOAT_EQ(y, -32.0F);
+  EXPECT_DOUBLE_EQ(z, 8.0);
+
+  // Assigning a cell to a cell copies the values instead of rebinding the proxy
+  field[0, 0] = field[1, 2];
+  EXPECT_FLOAT_EQ((vx[0, 0]), 1.0F);
+  EXPECT_FLOAT_EQ((vy[0, 0]), 2.0F);
+  EXPECT_DOUBLE_EQ((t[0, 0]), 3.0);
+}
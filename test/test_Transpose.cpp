@@ -0,0 +1,80 @@
+#include <gtest/gtest.h>
+
+#include <Igor/MdArray.hpp>
+#include <Igor/Transpose.hpp>
+
+template <typename T, typename Layout, typename... Sizes>
+auto make_iota(Sizes... n) -> Igor::MdArray<T, std::dextents<size_t, sizeof...(Sizes)>, Layout> {
+  Igor::MdArray<T, std::dextents<size_t, sizeof...(Sizes)>, Layout> res(n...);
+  size_t count = 0;
+  Igor::for_each_index(res, [&](auto... idx) { res[idx...] = static_cast<T>(count++); });
+  return res;
+}
+
+template <typename T>
+void check_rank2(size_t m, size_t n) {
+  const auto left = make_iota<T, std::layout_left>(m, n);
+
+  Igor::MdArray<T, std::dextents<size_t, 2>> right(m, n);
+  Igor::convert_layout(left, right);
+  Igor::for_each_index(right, [&](size_t i, size_t j) { ASSERT_EQ((right[i, j]), (left[i, j])); });
+
+  Igor::MdArray<T, std::dextents<size_t, 2>, std::layout_left> back(m, n);
+  back.copy_from(right);
+  Igor::for_each_index(back, [&](size_t i, size_t j) { ASSERT_EQ((back[i, j]), (left[i, j])); });
+
+  Igor::MdArray<T, std::dextents<size_t, 2>> transposed(n, m);
+  Igor::transpose(right, transposed);
+  Igor::for_each_index(right,
+                       [&](size_t i, size_t j) { ASSERT_EQ((transposed[j, i]), (right[i, j])); });
+  Igor::MdArray<T, std::dextents<size_t, 2>> transposed_left(n, m);
+  Igor::transpose(left, transposed_left);
+  Igor::for_each_index(
+      left, [&](size_t i, size_t j) { ASSERT_EQ((transposed_left[j, i]), (left[i, j])); });
+}
+
+TEST(TestTranspose, Rank2) {
+  // Sizes that are not multiples of the SIMD tile or the cache block
+  check_rank2<float>(37, 53);
+  check_rank2<double>(64, 9);
+  check_rank2<int>(1, 17);
+  // Large enough to be processed in parallel
+  check_rank2<double>(513, 1031);
+}
+
+TEST(TestTranspose, Rank3) {
+  constexpr size_t a = 13;
+  constexpr size_t b = 5;
+  constexpr size_t c = 35;
+  const auto left    = make_iota<float, std::layout_left>(a, b, c);
+
+  Igor::MdArray<float, std::dextents<size_t, 3>> right(a, b, c);
+  Igor::convert_layout(left, right);
+  Igor::for_each_index(
+      right, [&](size_t i, size_t j, size_t k) { ASSERT_EQ((right[i, j, k]), (left[i, j, k])); });
+
+  Igor::MdArray<double, std::dextents<size_t, 3>> dright(a, b, c);
+  Igor::MdArray<double, std::dextents<size_t, 3>> dtransposed(c, b, a);
+  Igor::for_each_index(dright, [&](size_t i, size_t j, size_t k) {
+    dright[i, j, k] = static_cast<double>(i * 10000 + j * 100 + k);
+  });
+  Igor::transpose(dright, dtransposed);
+  Igor::for_each_index(dright, [&](size_t i, size_t j, size_t k) {
+    ASSERT_EQ((dtransposed[k, j, i]), (dright[i, j, k]));
+  });
+}
+
+TEST(TestTranspose, Strided) {
+  // Non left/right layouts fall back to an element-wise copy
+  const auto src = make_iota<int, std::layout_right>(6, 4);
+  Igor::MdArray<int, std::dextents<size_t, 2>> dst(4, 3);
+  const std::layout_stride::mapping mapping(std::dextents<size_t, 2>(6, 2),
+                                            std::array<size_t, 2>{4UZ, 2UZ});
+  const std::mdspan<const int, std::dextents<size_t, 2>, std::layout_stride> every_other(
+      src.get_data(), mapping);
+  const std::mdspan<int, std::dextents<size_t, 2>> dst_view(dst.get_data(), 2, 6);
+  Igor::transpose(every_other, dst_view);
+  Igor::for_each_index(every_other, [&](size_t i, size_t j) {
+    EXPECT_EQ((dst_view[j, i]), (src[i, 2 * j]));
+  });
+}